@@ -0,0 +1,67 @@
+#pragma once
+#include "GameDefs.h"
+
+// File: BoardTraits.h
+// Description:
+//   What every possible map character means, in one 256-entry table built at compile time.
+//   The room compiler classifies each character of a screen file with a single lookup
+//   instead of a chain of comparisons per object type.
+
+enum CellKind : unsigned char {
+    CELL_UNKNOWN,       // not a legal map character - replaced with a space
+    CELL_EMPTY,
+    CELL_WALL,
+    CELL_DOOR,
+    CELL_KEY,
+    CELL_BOMB,
+    CELL_SWITCH,
+    CELL_TORCH,
+    CELL_RIDDLE,
+    CELL_SPRING,
+    CELL_OBSTACLE,
+    CELL_TELEPORT,
+    CELL_LEGEND,
+    CELL_KIND_COUNT
+};
+
+struct CellTrait {
+    CellKind kind;
+    bool legendSafe;    // the legend may be drawn over it (empty cells and outer walls only)
+};
+
+struct BoardTraitTable {
+    CellTrait traits[256];
+};
+
+constexpr void setTrait(BoardTraitTable& t, char c, CellKind kind, bool legendSafe = false)
+{
+    t.traits[static_cast<unsigned char>(c)].kind = kind;
+    t.traits[static_cast<unsigned char>(c)].legendSafe = legendSafe;
+}
+
+constexpr BoardTraitTable makeBoardTraits()
+{
+    BoardTraitTable t{};        // everything else stays CELL_UNKNOWN
+
+    setTrait(t, ' ', CELL_EMPTY, true);
+    setTrait(t, BOARD_WALL, CELL_WALL, true);
+    setTrait(t, WALL_VERT, CELL_WALL);
+    setTrait(t, WALL_HORIZ, CELL_WALL);
+    for (char c = DOOR_MIN_CHAR; c <= DOOR_MAX_CHAR; c++)
+        setTrait(t, c, CELL_DOOR);
+    setTrait(t, BOARD_KEY, CELL_KEY);
+    setTrait(t, BOARD_BOMB, CELL_BOMB);
+    setTrait(t, BOARD_SWITCH_ON, CELL_SWITCH);
+    setTrait(t, BOARD_SWITCH_OFF, CELL_SWITCH);
+    setTrait(t, BOARD_TORCH, CELL_TORCH);
+    setTrait(t, BOARD_RIDDLE, CELL_RIDDLE);
+    setTrait(t, BOARD_SPRING, CELL_SPRING);
+    setTrait(t, BOARD_OBSTACLE, CELL_OBSTACLE);
+    setTrait(t, BOARD_TELEPORT, CELL_TELEPORT);
+    setTrait(t, LEGEND, CELL_LEGEND);
+    return t;
+}
+
+constexpr BoardTraitTable BOARD_TRAITS = makeBoardTraits();
+
+inline const CellTrait& cellTrait(char c) { return BOARD_TRAITS.traits[static_cast<unsigned char>(c)]; }
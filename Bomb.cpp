@@ -1,26 +1,15 @@
 #include "Bomb.h"
 
-// Arms the bomb at a new position and restarts the timer.
+// Arms the bomb at a new position with the timer that will detonate it.
 // The bomb becomes active and ticking immediately.
-void Bomb::arm(const Point& p)
+void Bomb::arm(const Point& p, const TimerHandle& _fuse)
 {
     pos = p;
-    timer = 5;     
+    fuse = _fuse;
     active = true;
     ticking = true;
 }
 
-bool Bomb::tick() {
-    if (!active || !ticking)
-        return false;         // If the bomb is not active or not ticking, no countdown occurs.
-
-    if (timer > 0) {          // Advances the countdown by one step.
-        timer--;
-        return (timer == 0);  // Returns true only when the timer reaches zero.
-    }
-    return false;          
-}
-
 std::vector<std::vector<Point>> Bomb::getBlastPattern(Point center, int radius) {
     std::vector<std::vector<Point>> allRays;
     allRays.reserve(9); // saving place in advance for all rays
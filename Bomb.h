@@ -1,21 +1,22 @@
 #pragma once
 #include "Point.h"
+#include "TimerWheel.h"
 #include <vector>
 
 class Bomb {
 private:
     Point pos;               // Position of the bomb of the board
     char figure = '@'; 
-    int timer = 5;           // Countdown until explosion
     bool active;             // True if the bomb exists on the board
-    bool ticking = false;    // True if the timer is currently decreasin
+    bool ticking = false;    // True if the bomb was armed and its fuse is burning
+    TimerHandle fuse;        // Timer that detonates the bomb (scheduled by the game)
 
 public:
-    Bomb() : pos(0, 0), figure('@'), timer(5), active(false), ticking(false)   // default ctor 
+    Bomb() : pos(0, 0), figure('@'), active(false), ticking(false)   // default ctor 
     {
     }
     explicit Bomb(Point _pos)                    // custom ctor     
-        : pos(_pos), timer(5), active(true), ticking(false)
+        : pos(_pos), active(true), ticking(false)
     {
     }    
 
@@ -27,9 +28,10 @@ public:
     void activate() { active = true; }
     void deactivate() { active = false; }
     bool isActive() const { return active; }
+    bool isShown() const { return active; }      // drawn on the board
     bool isTicking() const { return ticking; }
     void setTicking() { ticking = true; }
-    void arm(const Point& p);
-    bool tick();
+    const TimerHandle& getFuse() const { return fuse; }
+    void arm(const Point& p, const TimerHandle& _fuse);
     static std::vector<std::vector<Point>> getBlastPattern(Point center, int radius);
 };
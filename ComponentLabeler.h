@@ -0,0 +1,131 @@
+#pragma once
+#include "Point.h"
+#include <algorithm>
+#include <vector>
+
+// Finds the 4-connected groups of cells inside a rectangle of the screen in a single row-by-row pass.
+// Every cell takes the label of its left or upper neighbour and two labels that meet are merged
+// (union-find), so only the previous row is ever looked at and nothing recurses -
+// a huge solid block is as safe as a small one.
+// Used to build obstacles while a room loads (fed row by row, see RoomCompiler.h) and to split
+// an obstacle a bomb cut in two.
+// Storage grows with the cells collected (rooms may be of any size) and is kept for the next run.
+class ComponentLabeler {
+private:
+    std::vector<int> parent;            // union-find over the provisional labels
+    std::vector<int> rowLabels;         // labels of the previous and the current row (-1 = not a cell)
+    std::vector<int> cellLabel;         // provisional label of every collected cell
+    std::vector<Point> cells;           // collected cells in scan order
+    std::vector<int> groupOf;           // root label -> group number
+    std::vector<int> groupStart;
+    std::vector<Point> grouped;         // cells ordered by group
+
+    int find(int l) {
+        while (parent[l] != l) {
+            parent[l] = parent[parent[l]];
+            l = parent[l];
+        }
+        return l;
+    }
+    void unite(int a, int b) {          // the smaller label (scanned first) stays the root
+        a = find(a);
+        b = find(b);
+        if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+
+    Point origin;
+    int width = 0;
+    int row = 0;
+    int* prev = nullptr;
+    int* curr = nullptr;
+    int labels = 0, count = 0;
+
+public:
+    // Streaming use: begin() once, visit() every cell of a row from left to right, endRow(),
+    // and after the last row finish() hands out the groups. run() does all of it over a rectangle.
+    void begin(const Point& topLeft, int _width) {
+        origin = topLeft;
+        width = _width;
+        row = 0;
+        rowLabels.assign(2 * width, -1);
+        prev = rowLabels.data();
+        curr = prev + width;
+        labels = count = 0;
+        parent.clear();
+        cellLabel.clear();
+        cells.clear();
+    }
+
+    void visit(int col, bool isCell) {
+        if (!isCell) {
+            curr[col] = -1;
+            return;
+        }
+
+        int left = (col > 0) ? curr[col - 1] : -1;
+        int up = prev[col];
+        int l;
+        if (left < 0 && up < 0) {       // new group (for now)
+            l = labels++;
+            parent.push_back(l);
+        }
+        else if (left < 0) l = up;
+        else if (up < 0) l = left;
+        else {                          // left and up meet here - same group
+            l = left;
+            unite(left, up);
+        }
+
+        curr[col] = l;
+        cells.push_back(Point(origin.getX() + col, origin.getY() + row));
+        cellLabel.push_back(l);
+        count++;
+    }
+
+    void endRow() {
+        std::swap(prev, curr);
+        row++;
+    }
+
+    // Calls emit(cells, count) once per group, groups in the order their first cell was visited,
+    // cells of a group row by row.
+    template <typename Emit>
+    void finish(Emit emit) {
+        // number the groups by their root label, then bucket the cells by group (stable)
+        int groups = 0;
+        groupOf.resize(labels);
+        for (int l = 0; l < labels; l++)
+            if (find(l) == l) groupOf[l] = groups++;
+
+        groupStart.assign(groups + 1, 0);
+        grouped.resize(count);
+        for (int i = 0; i < count; i++)
+            groupStart[groupOf[find(cellLabel[i])] + 1]++;
+        for (int g = 0; g < groups; g++)
+            groupStart[g + 1] += groupStart[g];
+
+        for (int i = 0; i < count; i++) {
+            int g = groupOf[find(cellLabel[i])];
+            grouped[groupStart[g]++] = cells[i];
+        }
+        // groupStart[g] now holds the end of group g
+        for (int g = 0; g < groups; g++) {
+            int first = (g == 0) ? 0 : groupStart[g - 1];
+            emit(grouped.data() + first, groupStart[g] - first);
+        }
+    }
+
+    // Labels the cells inside a rectangle for which isCell(p) is true
+    template <typename IsCell, typename Emit>
+    void run(const Point& topLeft, const Point& bottomRight, IsCell isCell, Emit emit) {
+        int height = bottomRight.getY() - topLeft.getY() + 1;
+        begin(topLeft, bottomRight.getX() - topLeft.getX() + 1);
+
+        for (int r = 0; r < height; r++) {
+            for (int col = 0; col < width; col++)
+                visit(col, isCell(Point(topLeft.getX() + col, topLeft.getY() + r)));
+            endRow();
+        }
+        finish(emit);
+    }
+};
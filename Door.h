@@ -75,6 +75,7 @@ public:
 	bool getKeyStatus() const { return keyOK; }
 	bool getSwitchStatus() const { return switchOK; }
 	char getFigure() const { return figure; }
+	bool isShown() const { return true; }     // doors always stay on the board
 
 	// Update Functions
 	void updateKeyOK() {           // Changes key flag to true meaning all keys for the door have been used
@@ -83,6 +84,7 @@ public:
 	void updateSwitchOK(bool ok) {      // Changes switch flag - can change back to false since you can turn a switch back off\on
 		switchOK = ok;
 	}
+	void setDestination(int dest) { destRoom = dest; }    // rooms past 9 - the figure stays the digit on the board
 	void open() { isOpen = true; }          // Opens the door once all requirements are met
 	void useKey() { neededKeys--; }           // Decreases the number of required keys by one.
 
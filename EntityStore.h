@@ -0,0 +1,118 @@
+#pragma once
+#include "Point.h"
+#include "SlotMap.h"
+#include <vector>
+#include <cstddef>
+
+// Storage for the single-cell entities of a room (doors, switches, keys, bombs, torches, riddles).
+// The fields every draw / lookup pass needs - position, figure and whether the entity is shown
+// on the board - are kept in their own packed columns next to the objects, so those passes stream
+// through a few small arrays instead of walking the full objects (riddle texts, door rules...).
+// The columns follow the objects in the same order, removal swaps & pops both.
+// T must provide getPos(), getFigure() and isShown().
+// Whoever changes one of those fields on a stored object must call refresh() afterwards.
+template <typename T>
+class EntityStore {
+private:
+    SlotMap<T> objects;                     // full objects (cold data) + stable handles
+    ArenaVector<Point> positions;           // hot columns, index i describes objects[i]
+    ArenaVector<char> figures;
+    ArenaVector<unsigned char> shown;
+
+    void loadColumns(size_t i) {
+        positions[i] = objects[i].getPos();
+        figures[i] = objects[i].getFigure();
+        shown[i] = objects[i].isShown() ? 1 : 0;
+    }
+
+public:
+    using iterator = typename SlotMap<T>::iterator;
+    using const_iterator = typename SlotMap<T>::const_iterator;
+
+    explicit EntityStore(RoomArena* arena = nullptr)
+        : objects(arena), positions(ArenaAllocator<Point>(arena)),
+          figures(ArenaAllocator<char>(arena)), shown(ArenaAllocator<unsigned char>(arena)) {}
+
+    static size_t storageBytes(size_t n) {
+        return SlotMap<T>::storageBytes(n) + n * (sizeof(Point) + 2) + 3 * alignof(Point);
+    }
+
+    void reserve(size_t n) {
+        objects.reserve(n);
+        positions.reserve(n);
+        figures.reserve(n);
+        shown.reserve(n);
+    }
+
+    EntityHandle insert(const T& item) {
+        EntityHandle h = objects.insert(item);
+        positions.push_back(item.getPos());
+        figures.push_back(item.getFigure());
+        shown.push_back(item.isShown() ? 1 : 0);
+        return h;
+    }
+
+    void eraseAt(size_t i) {
+        size_t last = objects.size() - 1;
+        objects.eraseAt(i);         // moves the last object into i
+        if (i != last) {
+            positions[i] = positions[last];
+            figures[i] = figures[last];
+            shown[i] = shown[last];
+        }
+        positions.pop_back();
+        figures.pop_back();
+        shown.pop_back();
+    }
+
+    void release() {            // see SlotMap::release()
+        objects.release();
+        ArenaVector<Point>(positions.get_allocator()).swap(positions);
+        ArenaVector<char>(figures.get_allocator()).swap(figures);
+        ArenaVector<unsigned char>(shown.get_allocator()).swap(shown);
+    }
+
+    void copyFrom(const EntityStore& other) {   // see SlotMap::copyFrom()
+        objects.copyFrom(other.objects);
+        positions.assign(other.positions.begin(), other.positions.end());
+        figures.assign(other.figures.begin(), other.figures.end());
+        shown.assign(other.shown.begin(), other.shown.end());
+    }
+
+    // Re-reads the hot fields of an object after it was changed
+    void refreshAt(size_t i) { loadColumns(i); }
+    void refresh(const EntityHandle& h) {
+        int i = objects.indexOf(h);
+        if (i >= 0) loadColumns(i);
+    }
+
+    // index of the first entity at p, -1 if none (onlyShown skips collected / hidden ones)
+    int indexAt(const Point& p, bool onlyShown = false) const {
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] == p && (!onlyShown || shown[i]))
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    template <typename Fn>
+    void forEachShown(Fn fn) const {        // fn(pos, figure) for every entity drawn on the board
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (shown[i]) fn(positions[i], figures[i]);
+        }
+    }
+
+    T* get(const EntityHandle& h) { return objects.get(h); }
+    const T* get(const EntityHandle& h) const { return objects.get(h); }
+    EntityHandle handleAt(size_t i) const { return objects.handleAt(i); }
+
+    size_t size() const { return objects.size(); }
+    bool empty() const { return objects.empty(); }
+    T& operator[](size_t i) { return objects[i]; }
+    const T& operator[](size_t i) const { return objects[i]; }
+
+    iterator begin() { return objects.begin(); }
+    iterator end() { return objects.end(); }
+    const_iterator begin() const { return objects.begin(); }
+    const_iterator end() const { return objects.end(); }
+};
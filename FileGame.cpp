@@ -1,6 +1,6 @@
 #include "FileGame.h"
 
-FileGame::FileGame(bool silent) : GameBase(), silentMode(silent) { }  
+FileGame::FileGame(bool silent, bool binary) : GameBase(), silentMode(silent), binaryMode(binary) { }  
 
 FileGame::~FileGame() = default; 
 
@@ -16,19 +16,28 @@ bool FileGame::loadFileGameResources()
         return false;
     }
 
-    // Load + validate recorded gameplay steps 
-    if (!loadStepsFromFile("adv-world.steps")) {
-        return false;
+    if (binaryMode) {
+        // Steps, results and state hashes from one recording
+        if (!loadRecording(Recording::DEFAULT_FILE)) {
+            return false;
+        }
     }
+    else {
+        // Load + validate recorded gameplay steps 
+        if (!loadStepsFromFile("adv-world.steps")) {
+            return false;
+        }
 
-    // Load + validate recorded gameplay steps 
-    if (!loadResultsFromFile("adv-world.results")) {
-        return false;
+        // Load + validate recorded gameplay steps 
+        if (!loadResultsFromFile("adv-world.results")) {
+            return false;
+        }
     }
 
     if (silentMode) {
-        // create container for actual results for comparing later
+        // actual results are checked the moment the game produces them
         setResults(new Results());
+        getResults()->setVerifier(verifier.get());
     }
 
     return true;
@@ -36,21 +45,22 @@ bool FileGame::loadFileGameResources()
 
 bool FileGame::loadStepsFromFile(const std::string& filename)
 {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    std::unique_ptr<LineStream> file(new LineStream());
+    if (!file->open(filename)) {
         showError("Failed to open steps file.");
         return false;
     }
     
     // Validate screen files listed in header
-    if (!validateScreensHeader(file)) {
+    if (!validateScreensHeader(*file)) {
         return false;
     }
     
-    // Read steps from file
-    Steps* loadedSteps = Steps::loadSteps(file);
+    // Steps are read from the file as the game reaches them
+    std::string errorMsg;
+    Steps* loadedSteps = Steps::openSteps(std::unique_ptr<StepSource>(new TextStepSource(std::move(file))), errorMsg);
     if (!loadedSteps) {
-        showError("Failed to parse steps.");
+        showError("Failed to parse steps.\n" + errorMsg);
         return false;
     }
 
@@ -60,57 +70,64 @@ bool FileGame::loadStepsFromFile(const std::string& filename)
 
 bool FileGame::loadResultsFromFile(const std::string& filename)
 {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    std::unique_ptr<LineStream> file(new LineStream());
+    if (!file->open(filename)) {
         showError("Failed to open results file.");
         return false;
     }
     
     // Validate screen files listed in header
-    if (!validateScreensHeader(file)) {
+    if (!validateScreensHeader(*file)) {
         return false;
     }
     
-    // Read expected results (stream is positioned after header)
-    expectedResults = Results::loadResults(file);
-    if (!expectedResults) {
-        showError("Failed to read results.");
-        return false;
-    }
-
+    // Expected results are read (stream is positioned after header) as the game reaches them
+    expectResults(Results::openResults(std::unique_ptr<ResultSource>(new TextResultSource(std::move(file)))));
     return true;
 }
 
-bool FileGame::validateScreensHeader(std::ifstream& file){
-    std::string line;
-    std::vector<std::string> screensFromFile;
-    
-    // Expect header line: "# screens"
-    if (!std::getline(file, line)) {
-        showError("Screen header not found.");
+void FileGame::expectResults(Results* expected)
+{
+    verifier.reset(new ResultVerifier(expected, [this] { return describePlayers(); }));
+}
+
+bool FileGame::loadRecording(const std::string& filename)
+{
+    std::string errorMsg;
+    recording.reset(new Recording());
+    if (!recording->open(filename, errorMsg)) {
+        showError("Failed to open recording.\n" + errorMsg);
         return false;
     }
-    
-    if (line != "# screens") {
-        showError("Screen header not found.");
+
+    // The same rooms - by content, whatever their files are called now
+    if (!sameRooms(recording->getScreens(), getScreenIds())) {
+        showError("Screen files changed since the game was recorded.");
         return false;
     }
-    
-    // Read screen file names (one per line)
-    while (std::getline(file, line)) {        
-        if (line.empty()) {
-            continue;
-        }
 
-        if (line[0] == '#') {
-            break; 
-        }
-        
-        screensFromFile.push_back(line);
+    Steps* loadedSteps = Steps::openSteps(recording->steps(), errorMsg);
+    if (!loadedSteps) {
+        showError("Failed to parse steps.\n" + errorMsg);
+        return false;
     }
-    auto loadedScreens = getScreenSourceFiles();
-    
-    if (screensFromFile != loadedScreens) {
+    setSteps(loadedSteps);
+    expectResults(Results::openResults(recording->results()));
+
+    hasNextHash = recording->nextStateHash(nextHashIteration, nextHash);
+    return true;
+}
+
+bool FileGame::validateScreensHeader(LineStream& text){
+    std::vector<ScreenId> screensFromFile;
+    std::string errorMsg;
+
+    if (!Recording::readScreensHeader(text, screensFromFile, errorMsg)) {
+        showError(errorMsg);
+        return false;
+    }
+    // Older files only name the screens - those are matched by name
+    if (!sameRooms(screensFromFile, getScreenIds())) {
         showError("Screen files listed in file do not match loaded screens.");
         return false;
     }
@@ -119,7 +136,32 @@ bool FileGame::validateScreensHeader(std::ifstream& file){
 }
 
 void FileGame::handleInput() {
+    checkStateHash();
+    if (silentMode)
+        verifier->checkMissingBefore(gameCycles);
+
+    // Fail fast - the rest of the replay can't pass anymore
+    if (verifier->hasFailed() || !failures.empty()) {
+        gameOver = true;
+        isRunning = false;
+        return;
+    }
+
+    if (!silentMode)
+        verifier->skipBefore(gameCycles);   // nothing is checked - just keep up with the game
+
+    if (!verifier->getReadError().empty()) {
+        showError("Failed to read results.\n" + verifier->getReadError());
+        isRunning = false;
+        return;
+    }
+
     if (getSteps()->isEmpty()) {  // No more recorded steps available
+        if (!getSteps()->getReadError().empty()) {
+            showError("Failed to parse steps.\n" + getSteps()->getReadError());
+            isRunning = false;
+            return;
+        }
 
         // Game already ended normally - exit run loop
         if (gameOver) {
@@ -169,53 +211,22 @@ void FileGame::onGameEnd() {
     }
 }
 
-void FileGame::compareResults() {
-    // Assume success until a mismatch is found
-    testPassed = true;
-    failures.clear();
-
-    // Get expected (from file) and actual (from game run) results
-    const auto& expected = expectedResults->getResults();
-    const auto& actual = getResults()->getResults();
-
-    auto itExp = expected.begin();
-    auto itAct = actual.begin();
-
-    // Compare results one by one, in chronological order
-    while (itExp != expected.end() && itAct != actual.end())
-    {
-        // Check that the event occurred at the same game cycle
-        if (itExp->first != itAct->first) {
-            testPassed = false;
-            failures.push_back(
-                "Iteration mismatch: expected " +
-                std::to_string(itExp->first) +
-                ", got " +
-                std::to_string(itAct->first)
-            );
-            return;
-        }
-
-        // Check that the logical result is the same
-        if (!(itExp->second == itAct->second)) {
-            testPassed = false;
-            failures.push_back(
-                "Result mismatch at iteration " +
-                std::to_string(itExp->first)
-            );
-            return;
-        }
+// The state is hashed where the recording game hashed it - before the input of the cycle
+void FileGame::checkStateHash() {
+    if (!hasNextHash || nextHashIteration != gameCycles)
+        return;
 
-        ++itExp;
-        ++itAct;
-    }
+    if (silentMode && failures.empty() && !verifier->hasFailed() && stateHash() != nextHash)
+        failures.push_back("State mismatch at iteration " + std::to_string(gameCycles) + "\nPlayers:" + describePlayers());
+    hasNextHash = recording->nextStateHash(nextHashIteration, nextHash);
+}
 
-    // Check for extra or missing results
-    if (itExp != expected.end() || itAct != actual.end()) {
-        testPassed = false;
-        failures.push_back("Number of results mismatch");
-    }
+void FileGame::compareResults() {
+    // Every result was checked as it came - now no expected results may be left
+    if (failures.empty() && !verifier->finish())
+        failures.push_back(verifier->getFailure() + "\n" + verifier->getReport());
 
+    testPassed = failures.empty();
 }
 
 void FileGame::printTestSummary() const{  
@@ -232,16 +243,16 @@ void FileGame::printTestSummary() const{
     }
 }
 
-bool FileGame::getRiddleAnswer(Riddle* riddle, bool& outSolved)
+bool FileGame::getRiddleAnswer(Riddle* riddle, int, bool& outSolved)
 {
     // Get expected riddle answer for this iteration
     std::string expA;
 
-    if (!expectedResults->getRiddleAtIteration(gameCycles, expA)) {
+    if (!verifier->answerAt(gameCycles, expA)) {
         return false;  // No riddle found in results file at this iteration
     }
     // Compare file answer to riddle's correct answer
-    outSolved = matchRiddleAnswer(riddle->getAnswer(), expA);
+    outSolved = riddle->accepts(expA);
     if (silentMode) {
         // Record actual result
         getResults()->addRiddleRes(gameCycles, riddle->getQuestion(), expA, outSolved);
@@ -2,21 +2,32 @@
 #include "GameBase.h"
 #include "Steps.h"
 #include "Results.h"
+#include "Recording.h"
+#include "ResultVerifier.h"
+#include <memory>
 
 constexpr int FALSE_SILENT_DELAY=10;
 
 class FileGame : public GameBase {
 private:
     bool silentMode; // true in -load -silent mode
-    Results* expectedResults = nullptr;  // expected results loaded from .results file
+    bool binaryMode; // true in -load -rec mode: steps & results come from one binary recording
+    std::unique_ptr<ResultVerifier> verifier;   // expected results, read from the recording as the game goes
+    std::unique_ptr<Recording> recording;
+    size_t nextHashIteration = 0;        // next recorded state hash (binary mode)
+    std::uint64_t nextHash = 0;
+    bool hasNextHash = false;
     bool testPassed = false;     
     std::vector<std::string> failures;   // descriptions of test mismatches
 
+    void checkStateHash();
+    void expectResults(Results* expected);
     void compareResults();
     void printTestSummary() const;
     bool loadStepsFromFile(const std::string& filename);
     bool loadResultsFromFile(const std::string& filename);
-    bool validateScreensHeader(std::ifstream& file);
+    bool loadRecording(const std::string& filename);
+    bool validateScreensHeader(LineStream& text);
 
 protected:
     void handleInput() override;     // Reads input from steps file instead of keyboard
@@ -28,9 +39,9 @@ protected:
         return silentMode ? 0 : LOAD_DELAY;
     }
 
-    bool getRiddleAnswer(Riddle* riddle, bool& outSolved) override;
+    bool getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) override;
 public:
-    explicit FileGame(bool silent);    
+    explicit FileGame(bool silent, bool binary = false);    
     ~FileGame();
 
     bool loadFileGameResources();
@@ -0,0 +1,146 @@
+#include "FrameCompositor.h"
+#include "GameDefs.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+    constexpr char UNKNOWN_CELL = '\0';     // never drawn - every cell differs from it
+
+    // Columns x rows of panes for a number of rooms
+    void gridFor(int count, int& cols, int& rows) {
+        cols = (count <= 1) ? 1 : (count <= 4) ? 2 : (count <= 6) ? 3 : 4;
+        rows = (count + cols - 1) / cols;
+    }
+
+    // Size of part i when 'total' cells are split into 'parts' with a separator between them
+    int partSize(int total, int parts, int i) {
+        int free = total - (parts - 1);
+        return free / parts + (i < free % parts ? 1 : 0);
+    }
+}
+
+FrameCompositor::FrameCompositor()
+    : frame(NUM_CELLS, ' '), shown(NUM_CELLS, UNKNOWN_CELL)
+{
+    layout(1);
+}
+
+void FrameCompositor::layout(int count)
+{
+    int cols, rows;
+    gridFor(std::max(count, 1), cols, rows);
+
+    std::fill(frame.begin(), frame.end(), ' ');
+    panes.clear();
+
+    int y = 0;
+    for (int r = 0; r < rows; r++) {
+        int height = partSize(SCREEN_HEIGHT, rows, r);
+        int x = 0;
+        for (int c = 0; c < cols; c++) {
+            int width = partSize(SCREEN_WIDTH, cols, c);
+            if (static_cast<int>(panes.size()) < std::max(count, 1)) {
+                Pane pane;
+                pane.at = Point(x, y);
+                pane.width = width;
+                pane.height = height;
+                panes.push_back(pane);
+            }
+            x += width;
+            if (c < cols - 1) {             // separator column
+                for (int row = y; row < y + height; row++)
+                    frame[row * SCREEN_WIDTH + x] = PANE_V_SEPARATOR;
+                x++;
+            }
+        }
+        y += height;
+        if (r < rows - 1) {                 // separator row
+            std::fill(frame.begin() + y * SCREEN_WIDTH, frame.begin() + (y + 1) * SCREEN_WIDTH, PANE_H_SEPARATOR);
+            y++;
+        }
+    }
+    changing.set();
+    repaintAll = true;
+}
+
+void FrameCompositor::write(int pane, const Point& at, const char* chars, int count)
+{
+    char* cell = frame.data() + at.getY() * SCREEN_WIDTH + at.getX();
+    if (std::equal(chars, chars + count, cell))
+        return;
+    std::copy(chars, chars + count, cell);
+
+    changing.set(at.getY());
+
+    Pane& p = panes[pane];
+    p.dirtyTop = std::min(p.dirtyTop, at.getY());
+    p.dirtyBottom = std::max(p.dirtyBottom, at.getY());
+}
+
+// Appends the runs of row y in [left, right) that differ from the terminal
+void FrameCompositor::emitRow(int y, int left, int right)
+{
+    const char* want = frame.data() + y * SCREEN_WIDTH;
+    char* have = shown.data() + y * SCREEN_WIDTH;
+
+    int x = left;
+    while (x < right) {
+        if (want[x] == have[x]) {
+            x++;
+            continue;
+        }
+        int end = x + 1;
+        while (end < right && want[end] != have[end])
+            end++;
+
+        char move[16];
+        int len = std::snprintf(move, sizeof(move), "\033[%d;%dH", y + 1, x + 1);
+        out.append(move, len);
+        out.append(want + x, end - x);
+        std::copy(want + x, want + end, have + x);
+        x = end;
+    }
+}
+
+void FrameCompositor::present()
+{
+    if (!detached && Utils::screenClears() != shownClears) {
+        shownClears = Utils::screenClears();
+        repaintAll = true;
+    }
+
+    out.clear();
+    if (repaintAll) {
+        std::fill(shown.begin(), shown.end(), UNKNOWN_CELL);
+        for (int y = 0; y < SCREEN_HEIGHT; y++)
+            emitRow(y, 0, SCREEN_WIDTH);
+        repaintAll = false;
+    }
+    else {
+        for (const Pane& p : panes) {
+            for (int y = p.dirtyTop; y <= p.dirtyBottom; y++)
+                emitRow(y, p.at.getX(), p.at.getX() + p.width);
+        }
+    }
+    for (Pane& p : panes) {
+        p.dirtyTop = SCREEN_HEIGHT;
+        p.dirtyBottom = -1;
+    }
+
+    changed = changing;
+    changing.reset();
+
+    if (detached) {
+        pending += out;
+        return;
+    }
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    std::cout.flush();
+}
+
+void FrameCompositor::takeOutput(std::string& into)
+{
+    into += pending;
+    pending.clear();
+}
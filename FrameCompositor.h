@@ -0,0 +1,66 @@
+#pragma once
+#include "Point.h"
+#include "Utils.h"
+#include <bitset>
+#include <string>
+#include <vector>
+
+// File: FrameCompositor.h
+// Description:
+//   Builds each frame in memory and sends it to the terminal in one write.
+//   The terminal is split into panes - one per room that is shown (side by side for two rooms,
+//   a grid for more), with a separator line between them. Everything a pane draws lands in the
+//   frame buffer; a pane remembers the rows where a cell really changed, and present() compares
+//   only those rows with what the terminal already shows and emits the differing runs.
+//   A frame costs the cells of the terminal, however many rooms share it, and what is written is
+//   what changed. Whatever else cleared the screen (menus, riddles, messages) is noticed through
+//   Utils::screenClears() and repaints the whole frame.
+//   The rows that changed in the frame just presented are kept for spectators (see FrameShare.h).
+//   A detached compositor writes nothing: the frames pile up for takeOutput() - a game hosted by a
+//   server sends them to its player itself (see GameSession.h).
+
+class FrameCompositor {
+private:
+    struct Pane {
+        Point at;                   // terminal cell of its top left
+        int width = 0;
+        int height = 0;
+        int dirtyTop = SCREEN_HEIGHT;   // changed rows since the last present (top > bottom - none)
+        int dirtyBottom = -1;
+    };
+
+    std::vector<char> frame;        // the frame being composed, SCREEN_WIDTH x SCREEN_HEIGHT
+    std::vector<char> shown;        // what the terminal shows
+    std::vector<Pane> panes;
+    bool repaintAll = true;         // the terminal's content is unknown
+    unsigned shownClears = 0;       // Utils::screenClears() at the last present
+    std::string out;                // escape sequences and text of one frame (reused)
+    std::bitset<SCREEN_HEIGHT> changing;    // rows written since the last present
+    std::bitset<SCREEN_HEIGHT> changed;     // rows that changed in the presented frame
+    bool detached = false;
+    std::string pending;            // detached: presented, not taken yet
+
+    void emitRow(int y, int left, int right);
+
+public:
+    FrameCompositor();
+
+    // Splits the terminal into 'count' panes (at least one). The frame is blanked and fully repainted
+    void layout(int count);
+    int paneCount() const { return static_cast<int>(panes.size()); }
+    const Point& paneAt(int pane) const { return panes[pane].at; }
+    int paneWidth(int pane) const { return panes[pane].width; }
+    int paneHeight(int pane) const { return panes[pane].height; }
+
+    // Draws text at a terminal cell - the caller (Viewport) keeps it inside the pane
+    void write(int pane, const Point& at, const char* chars, int count);
+
+    void present();                 // one write to the console
+    void repaint() { repaintAll = true; }  // the terminal shows something else now
+
+    void detach() { detached = true; }
+    void takeOutput(std::string& into);    // appends the frames presented since the last call
+
+    const char* getCells() const { return frame.data(); }       // the presented frame, row by row
+    const std::bitset<SCREEN_HEIGHT>& changedRows() const { return changed; }
+};
@@ -0,0 +1,160 @@
+#include "FrameShare.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+const char* const FrameShare::NAME = "Local\\adv-world-frames";
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+const char* const FrameShare::NAME = "/adv-world-frames";
+#endif
+
+namespace {
+    constexpr int READ_ATTEMPTS = 8;    // a reader gives up on a frame the writer keeps overwriting
+}
+
+bool FrameShare::map(bool create)
+{
+    const size_t size = sizeof(SharedFrames);
+    void* view = nullptr;
+
+#ifdef _WIN32
+    HANDLE mapping = create
+        ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(size), NAME)
+        : OpenFileMappingA(FILE_MAP_READ, FALSE, NAME);
+    if (!mapping)
+        return false;
+    view = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    mappingHandle = mapping;
+#else
+    int fd = create ? shm_open(NAME, O_CREAT | O_RDWR, 0644) : shm_open(NAME, O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    if (create && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(NAME);
+        return false;
+    }
+    view = mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);                        // the mapping stays valid without the descriptor
+    if (view == MAP_FAILED) {
+        if (create) shm_unlink(NAME);
+        return false;
+    }
+#endif
+    shared = static_cast<SharedFrames*>(view);
+    owner = create;
+    return true;
+}
+
+bool FrameShare::create()
+{
+    close();
+    if (!map(true))
+        return false;
+
+    // A game that crashed may have left its frames behind - start over
+    std::memset(static_cast<void*>(shared), 0, sizeof(SharedFrames));
+    shared->magic = MAGIC;
+    shared->version = VERSION;
+    shared->width = SCREEN_WIDTH;
+    shared->height = SCREEN_HEIGHT;
+    for (std::bitset<SCREEN_HEIGHT>& rows : stale)
+        rows.set();
+    shared->live.store(1, std::memory_order_release);
+    return true;
+}
+
+bool FrameShare::attach()
+{
+    close();
+    if (!map(false))
+        return false;
+
+    if (shared->magic != MAGIC || shared->version != VERSION ||
+        shared->width != SCREEN_WIDTH || shared->height != SCREEN_HEIGHT) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void FrameShare::close()
+{
+    if (!shared)
+        return;
+    if (owner)
+        shared->live.store(0, std::memory_order_release);   // spectators still attached see the game ended
+
+#ifdef _WIN32
+    UnmapViewOfFile(shared);
+    CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    munmap(static_cast<void*>(shared), sizeof(SharedFrames));
+    if (owner)
+        shm_unlink(NAME);
+#endif
+    shared = nullptr;
+    owner = false;
+}
+
+void FrameShare::publish(size_t tick, const char* cells, const std::bitset<SCREEN_HEIGHT>& changed)
+{
+    if (!shared || !owner)
+        return;
+
+    std::uint32_t number = shared->published.load(std::memory_order_relaxed);
+    int s = static_cast<int>(number % FRAME_RING_SLOTS);
+    for (std::bitset<SCREEN_HEIGHT>& rows : stale)
+        rows |= changed;
+
+    SharedFrame& slot = shared->ring[s];
+    std::uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    FrameData& data = slot.data;
+    data.number = number;
+    data.tick = static_cast<std::uint32_t>(tick);
+    std::memset(data.dirtyRows, 0, sizeof(data.dirtyRows));
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        if (changed[y])
+            data.dirtyRows[y / 32] |= 1u << (y % 32);
+        if (stale[s][y])
+            std::memcpy(data.cells[y], cells + y * SCREEN_WIDTH, SCREEN_WIDTH);
+    }
+    stale[s].reset();
+
+    slot.seq.store(seq + 2, std::memory_order_release);
+    shared->published.store(number + 1, std::memory_order_release);
+}
+
+bool FrameShare::latest(FrameData& out) const
+{
+    if (!shared)
+        return false;
+
+    for (int attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+        std::uint32_t published = shared->published.load(std::memory_order_acquire);
+        if (published == 0)
+            return false;
+
+        const SharedFrame& slot = shared->ring[(published - 1) % FRAME_RING_SLOTS];
+        std::uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1u)
+            continue;               // being written
+        std::memcpy(&out, &slot.data, sizeof(FrameData));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.seq.load(std::memory_order_relaxed) == before && out.number == published - 1)
+            return true;
+    }
+    return false;
+}
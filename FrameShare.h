@@ -0,0 +1,80 @@
+#pragma once
+#include "Utils.h"
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+
+// File: FrameShare.h
+// Description:
+//   Publishes the game's frames in shared memory, so spectators in other terminals can mirror a
+//   live game or a replay (see Spectator.cpp) without touching the game's console output.
+//   The memory holds a ring of FRAME_RING_SLOTS frames. Each slot is a whole frame - its cells, an
+//   attribute byte per cell (0 - the game draws without colours), the tick it was drawn on and a
+//   bitmap of the rows that changed since the frame before it - guarded by a sequence lock: the
+//   writer makes the count odd while it copies and even again when the slot is complete, and a
+//   reader copies a slot and keeps the copy only if the count was even and the same before and after.
+//   The game never waits for a spectator. Publishing a frame copies only the rows that changed
+//   since its slot was last written - the changed rows of the last few frames.
+
+constexpr int FRAME_RING_SLOTS = 4;
+constexpr int DIRTY_WORDS = (SCREEN_HEIGHT + 31) / 32;
+
+struct FrameData {
+    std::uint32_t number;                   // frames published before this one
+    std::uint32_t tick;                     // game cycle it was drawn on
+    std::uint32_t dirtyRows[DIRTY_WORDS];   // bit y: row y changed since frame number - 1
+    char cells[SCREEN_HEIGHT][SCREEN_WIDTH];
+    char attrs[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+    bool isDirty(int row) const { return (dirtyRows[row / 32] >> (row % 32)) & 1u; }
+};
+
+struct SharedFrame {
+    std::atomic<std::uint32_t> seq;         // odd while the writer is copying into the slot
+    FrameData data;
+};
+
+struct SharedFrames {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::atomic<std::uint32_t> live;        // 0 once the game closed the share
+    std::atomic<std::uint32_t> published;   // frames published - the latest is in ring[(published - 1) % FRAME_RING_SLOTS]
+    SharedFrame ring[FRAME_RING_SLOTS];
+};
+
+class FrameShare {
+private:
+    SharedFrames* shared = nullptr;
+    bool owner = false;                     // created it (the game) - or attached to read it
+    std::bitset<SCREEN_HEIGHT> stale[FRAME_RING_SLOTS];     // per slot: rows changed since it was written
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#endif
+
+    bool map(bool create);
+
+public:
+    static constexpr std::uint32_t MAGIC = 0x53465741;     // "AWFS"
+    static constexpr std::uint32_t VERSION = 1;
+    static const char* const NAME;          // name of the shared memory
+
+    FrameShare() = default;
+    FrameShare(const FrameShare&) = delete;
+    FrameShare& operator=(const FrameShare&) = delete;
+    ~FrameShare() { close(); }
+
+    bool create();                          // the game - false if the shared memory cannot be made
+    bool attach();                          // a spectator, read only - false while no game shares its frames
+    void close();
+    bool isOpen() const { return shared != nullptr; }
+
+    // The game: the frame drawn on tick, and the rows that changed since the previous one
+    void publish(size_t tick, const char* cells, const std::bitset<SCREEN_HEIGHT>& changed);
+
+    // A spectator: copies the latest complete frame - false if no frame was published yet
+    // or the writer kept overwriting it
+    bool latest(FrameData& out) const;
+    bool isLive() const { return shared && shared->live.load(std::memory_order_acquire) != 0; }
+};
@@ -1,8 +1,12 @@
 #include "GameBase.h"
+#include "MappedFile.h"
 #include <iostream>
 #include <fstream>
 #include <cstdio>
 
+thread_local Results* GameBase::stagedResults = nullptr;
+thread_local std::vector<GameBase::RiddleEncounter>* GameBase::stagedRiddles = nullptr;
+
 // Game Functions
 GameBase::GameBase()
     : currRoomID(0),
@@ -12,37 +16,70 @@ GameBase::GameBase()
     gameOver(false),
     gameCycles(0)
 {
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
         playerRoom[i] = 0;
         roomsDone[i] = 0;
         playerFinished[i] = false;
         prevPos[i] = Point(0, 0);
+        pendingRoom[i] = -1;
     }
 }
 GameBase::~GameBase(){
-    Utils::showCursor();
+    if (!hosted)                // a hosted game never owned the console
+        Utils::showCursor();
     if (results)
         delete results;
     if (steps)
         delete steps;
 }
 
-std::vector<std::string> GameBase::getScreenSourceFiles() const {
-    // Used for saving metadata to allow consistent replay.
-    std::vector<std::string> files;
-    for (const auto& screen : screens) {
-        const std::string& file = screen.getSourceFile();
-        if (!file.empty()) {  
-            files.push_back(file);
+std::vector<ScreenId> GameBase::getScreenIds() const {
+    // Used for saving metadata to allow consistent replay (rooms not loaded yet included)
+    std::vector<ScreenId> ids;
+    for (size_t roomID = 0; roomID < roomFiles.size(); roomID++) {
+        if (!roomFiles[roomID].empty()) {
+            ids.emplace_back(roomFiles[roomID], roomHashes[roomID]);
         }
     }
-    return files;
+    return ids;
+}
+
+std::vector<std::string> GameBase::getPlayerKeys() const {
+    std::vector<std::string> keys;
+    for (int i = 0; i < numPlayers; i++)
+        keys.push_back(players[i].getKeys());
+    return keys;
+}
+
+// Recorded every few cycles in a binary recording, so playback notices the first cycle it drifted in
+std::uint64_t GameBase::stateHash() const {
+    std::uint64_t hash = Utils::HASH_SEED;
+    for (int i = 0; i < numPlayers; i++) {
+        const Player& p = players[i];
+        int state[] = { p.getPos().getX(), p.getPos().getY(), playerRoom[i],
+                        p.getLife(), p.getScore(), p.getDead() ? 1 : 0 };
+        hash = Utils::hashBytes(state, sizeof(state), hash);
+    }
+    return hash;
+}
+
+std::string GameBase::describePlayers() const {
+    std::ostringstream out;
+    for (int i = 0; i < numPlayers; i++) {
+        const Player& p = players[i];
+        out << "\n  P" << i + 1 << " '" << p.getFigure() << "' room " << playerRoom[i]
+            << " at (" << p.getPos().getX() << "," << p.getPos().getY() << ")"
+            << " life " << p.getLife() << " score " << p.getScore()
+            << " item '" << p.getInventoryChar() << "'"
+            << (p.getDead() ? " dead" : "") << (playerFinished[i] ? " finished" : "");
+    }
+    return out.str();
 }
 
 void GameBase::setGame() {
     gameOver = isRunning = false;
 
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
         playerFinished[i] = false;
         roomsDone[i] = 0;
         playerRoom[i] = -1;
@@ -57,15 +94,10 @@ void GameBase::run() {
     render();              // draw the initial room before any movement
 
     while (isRunning) {
-        gameCycles++;
-        handleInput();     // handle user's input
+        tick();
 
         if (!isRunning) break;   // input may request to leave run()
 
-        if (!gameOver) update(); // update world state only in active gameplay
-
-        if (!isRunning) break;
-
         render();                // redraw everything after update
         Utils::delay(getDelay());
     }
@@ -74,148 +106,395 @@ void GameBase::run() {
         onGameEnd();
     }
 }
-// Draws current room and both players.
+void GameBase::tick() {
+    gameCycles++;
+    handleInput();     // handle user's input
+
+    if (!isRunning) return;
+
+    if (!gameOver) update(); // update world state only in active gameplay
+}
+
+// Draws every room a player is still playing in, with its players, and sends the frame at once.
+// The legend goes to the shown room's pane.
 void GameBase::render()
 {
-    Screen& room = screens[currRoomID];
-
-    room.drawScreen();
-    drawPlayers();
+    layoutPanes();
+
+    const RoomPane* shown = &panes.front();
+    for (RoomPane& pane : panes) {
+        followPlayers(pane);
+        screens[pane.roomID].drawScreen(pane.view);
+        drawPlayers(pane);
+        if (pane.roomID == currRoomID)
+            shown = &pane;
+    }
 
-    isFinalRoom(currRoomID) ? displayFinalScoreboard() : displayLegend(room);
+    isFinalRoom(shown->roomID) ? displayFinalScoreboard(shown->view) : displayLegend(screens[shown->roomID], shown->view);
 
-    std::cout << std::flush;
+    frame.present();
+    spectators.publish(gameCycles, frame.getCells(), frame.changedRows());
 };
 
-// Updates game state for all players
+// Updates game state for all players - every room that has a player in it advances each tick
 void GameBase::update() {
-    Screen& room = screens[currRoomID];
-    room.clearIllumination();         
+    for (int i = 0; i < numPlayers; i++)
+        pendingRoom[i] = -1;
+
+    activeRooms.clear();
+    for (int i = 0; i < numPlayers; i++) {
+        if (!playerFinished[i] &&
+            std::find(activeRooms.begin(), activeRooms.end(), playerRoom[i]) == activeRooms.end())
+            activeRooms.push_back(playerRoom[i]);
+    }
+    std::sort(activeRooms.begin(), activeRooms.end());
+
+    // Rooms don't share state during a tick, so separate rooms are simulated side by side.
+    // Anything that leaves a room (room changes, results) is staged and merged afterwards.
+    int count = static_cast<int>(activeRooms.size());
+    roomEvents.resize(count);
+    roomRiddles.resize(count);
+    if (hosted) {               // the server's workers run games side by side already
+        for (int k = 0; k < count; k++)
+            updateRoom(activeRooms[k], roomEvents[k], roomRiddles[k]);
+    }
+    else
+        roomWorkers.run(count, [this](int k) { updateRoom(activeRooms[k], roomEvents[k], roomRiddles[k]); });
+
+    mergeRoomEffects();
+
+    handleTimers();       // advance all timers (every room) once per frame
+
+    if (allPlayersFinished()) {
+        gameOver = true;
+    }
+}
+
+// Simulates one room for one tick. May run on a worker thread, so it only touches this room,
+// the players standing in it and the (locked) timer wheel.
+// Movement runs in rounds of one step each: every player first states where it wants to go,
+// conflicts between players are settled, and only then the steps are carried out.
+void GameBase::updateRoom(int roomID, Results& events, std::vector<RiddleEncounter>& riddles) {
+    Screen& room = screens[roomID];
+    room.clearIllumination();
+    stagedResults = &events;
+    stagedRiddles = &riddles;
 
-    for (int i = 0; i < NUM_PLAYERS; i++)
-        prevPos[i] = players[i].getPos();
+    int stepsLeft[MAX_PLAYERS] = {};
+    int rounds = 0;
 
-    for (int i = 0; i < NUM_PLAYERS; i++) {
+    for (int i = 0; i < numPlayers; i++) {
         Player& player = players[i];
 
-        if (playerFinished[i] || playerRoom[i] != currRoomID)   // Player not in this room or already finished
+        if (playerFinished[i] || playerRoom[i] != roomID)   // Player not in this room or already finished
             continue;
 
-        // Respawn logic
-        if (player.getDead()) {
-            player.respawn();
+        // Dead players wait for their respawn timer
+        if (player.getDead())
             continue;
+
+        handleTorch(player);
+
+        stepsLeft[i] = player.getSpeed();       // speed > 1 means several steps (rounds) this tick
+        if (!player.isAccelerating())
+            player.stopAcceleration();          // speed left by an ended acceleration lasts this tick only
+        rounds = std::max(rounds, stepsLeft[i]);
+    }
+
+    for (int r = 0; r < rounds; r++) {
+        markOccupancy(roomID);
+
+        // 1. Intents
+        MoveIntent intents[MAX_PLAYERS];
+        for (int i = 0; i < numPlayers; i++) {
+            if (stepsLeft[i] > 0 && !players[i].getDead() && pendingRoom[i] == -1)
+                intents[i] = getIntent(players[i]);
         }
 
-        handleTorch(players[i]);
+        // 2. Player vs player conflicts
+        int order[MAX_PLAYERS];
+        int count = resolveIntents(roomID, intents, order);
 
-        room = screens[playerRoom[i]];
+        for (int i = 0; i < numPlayers; i++) {
+            if (intents[i].blocked)
+                stepsLeft[i] = 0;
+        }
 
-        int steps = player.getSpeed();
+        // 3. Steps - leaders before the players following them
+        for (int k = 0; k < count; k++) {
+            int i = order[k];
 
-        if (player.isAccelerating())
-            player.tickAcceleration();
+            liveCells[roomID].remove(players[i].getPos(), i);   // the moving player doesn't block itself
+
+            bool done = stepPlayer(i);
+            stepsLeft[i] = done ? 0 : stepsLeft[i] - 1;
+
+            if (!players[i].getDead())
+                liveCells[roomID].set(players[i].getPos(), i);
+        }
+    }
 
-        // Inner loop handles cell-by-cell movement if speed > 1.
-        for (int s = 0; s < steps; s++) {
-            // accelerated movement
-            if (player.isAccelerating()) {
-                bool stop = handleAcceleratedMovement(player, i);
-                if (stop) break;
+    stagedResults = nullptr;
+    stagedRiddles = nullptr;
+}
+
+// The cells a player is going to pass through in its next step (none when staying)
+GameBase::MoveIntent GameBase::getIntent(const Player& player) const {
+    MoveIntent intent;
+    intent.active = true;
+
+    if (player.isAccelerating()) {
+        intent.length = player.getAccelerationSubSteps(intent.path);
+    }
+    else if (player.getNextPos() != player.getPos()) {
+        intent.path[0] = player.getNextPos();
+        intent.length = 1;
+    }
+    return intent;
+}
 
-                continue; // skip normal movement block
+// Settles conflicts between the players of a room for one round, using where everyone stood
+// when the round started - only a race for the same cell goes by player number:
+//  - players entering the same cell: the lowest-numbered one gets it, the others stay
+//  - two players swapping cells (head-on) both stay
+//  - a player following another one steps after it, and gets in only if the cell was left
+// Fills 'order' with the players that step this round and returns their number.
+int GameBase::resolveIntents(int roomID, MoveIntent intents[], int order[]) {
+    const OccupancyGrid& start = startCells[roomID];
+    OccupancyGrid& claims = claimCells[roomID];
+
+    // Same cell entry
+    for (int i = 0; i < numPlayers; i++) {
+        for (int c = 0; c < intents[i].length; c++) {
+            int other = claims.at(intents[i].path[c]);
+
+            if (other == -1)
+                claims.set(intents[i].path[c], i);
+            else if (other != i) {   // claimed by a lower-numbered player - it goes first
+                intents[i].blocked = intents[i].contested = true;
+                break;
             }
+        }
+    }
+    claims.clear();
+
+    // Head-on swaps
+    for (int i = 0; i < numPlayers; i++) {
+        for (int c = 0; c < intents[i].length; c++) {
+            int other = start.at(intents[i].path[c]);
 
-            Point nextPos = player.getNextPos();
+            if (other != -1 && other != i && other > i && intents[other].enters(players[i].getPos())) {
+                intents[i].blocked = intents[other].blocked = true;
+                headOn(i, other);
+            }
+        }
+    }
 
-            if (room.isLegendCell(nextPos)) break;
+    // Players who lost a race for a cell hit it like a wall
+    for (int i = 0; i < numPlayers; i++) {
+        if (intents[i].contested && players[i].isAccelerating())
+            stopAcceleration(players[i]);
+    }
 
-            if (handleSprings(player)) break;  // may override direction/force
+    // Order: a player steps once every player standing on its path has stepped (or isn't moving)
+    bool placed[MAX_PLAYERS] = {};
+    int count = 0;
+    bool progress = true;
 
-            if (handleTeleports(player)) break;
+    while (progress) {
+        progress = false;
 
-            if (handleObstacles(player, nextPos)) break;  // may override direction/force
+        for (int i = 0; i < numPlayers; i++) {
+            if (!intents[i].active || intents[i].blocked || placed[i])
+                continue;
 
-            if (!handleRiddles(player)) {
-                player.setDirection(STAY);
-                break;
+            bool ready = true;
+            for (int c = 0; c < intents[i].length && ready; c++) {
+                int leader = start.at(intents[i].path[c]);
+                if (leader != -1 && leader != i && intents[leader].active && !intents[leader].blocked && !placed[leader])
+                    ready = false;
             }
 
-            if (!room.isCellFree(nextPos)) {
-                // If player's in acceleration, wall stops it
-                if (player.isAccelerating())
-                    player.stopAcceleration();
-                break;
+            if (ready) {
+                placed[i] = true;
+                order[count++] = i;
+                progress = true;
             }
+        }
+    }
 
-            if (playersCollide(i, nextPos)) break;  // other player collision
+    // Whoever is left waits on a circle of players - nobody can go first
+    for (int i = 0; i < numPlayers; i++) {
+        if (intents[i].active && !intents[i].blocked && !placed[i])
+            intents[i].blocked = true;
+    }
 
-            player.move();   // commit movement
+    return count;
+}
 
-            // Interactions
-            handleDoor(player);
-            handleSwitch(player);
-            handleCollectibles(player);
+// Two players ran into each other: a single accelerating one passes its acceleration on,
+// two accelerating ones stop each other
+void GameBase::headOn(int a, int b) {
+    bool accelA = players[a].isAccelerating();
+    bool accelB = players[b].isAccelerating();
 
-            // After actions player may have moved rooms or died
-            if (playerRoom[i] != currRoomID || player.getDead())
-                break;
+    if (accelA && accelB) {
+        stopAcceleration(players[a]);
+        stopAcceleration(players[b]);
+    }
+    else if (accelA)
+        bump(a, b);
+    else if (accelB)
+        bump(b, a);
+}
+
+// Performs one movement step of player i. Returns true when the player is done for this tick.
+bool GameBase::stepPlayer(int i) {
+    Player& player = players[i];
+    Screen& room = roomOf(player);
+
+    // accelerated movement
+    if (player.isAccelerating())
+        return handleAcceleratedMovement(player, i);
+
+    Point nextPos = player.getNextPos();
+
+    if (room.isLegendCell(nextPos)) return true;
+    if (!room.getSize().contains(nextPos)) return true;   // a gap in the border - nothing outside the room
+
+    if (handleSprings(player)) return true;  // may override direction/force
+
+    if (handleTeleports(player)) return true;
+
+    if (handleObstacles(player, nextPos)) return true;  // may override direction/force
+
+    if (!handleRiddles(player)) return true;    // waits for the answer (see answerRiddles)
+
+    if (!room.isCellFree(nextPos)) {
+        // If player's in acceleration, wall stops it
+        if (player.isAccelerating())
+            stopAcceleration(player);
+        return true;
+    }
+
+    if (playersCollide(i, nextPos)) return true;  // other player collision
+
+    player.move();   // commit movement
+
+    // Interactions
+    handleDoor(player);
+    handleSwitch(player);
+    handleCollectibles(player);
+
+    // After actions player may be leaving the room or died
+    return pendingRoom[i] != -1 || player.getDead();
+}
+
+// Marks where the room's players stand at the start of a movement round
+void GameBase::markOccupancy(int roomID) {
+    startCells[roomID].fit(screens[roomID].getSize());
+    claimCells[roomID].fit(screens[roomID].getSize());
+    startCells[roomID].clear();
+
+    for (int i = 0; i < numPlayers; i++) {
+        if (playerRoom[i] == roomID && !playerFinished[i] && !players[i].getDead()) {
+            startCells[roomID].set(players[i].getPos(), i);
+            prevPos[i] = players[i].getPos();
         }
     }
+    liveCells[roomID].copyFrom(startCells[roomID]);
+}
 
-    handleBombs();        // ticking bombs only once per frame
+// Applies what the rooms staged during the tick, room by room, so the outcome doesn't
+// depend on which room finished first
+void GameBase::mergeRoomEffects() {
+    bool moved = false;
 
-    if (playerFinished[PLAYER_1] && playerFinished[PLAYER_2]) {
-        gameOver = true;
+    for (size_t k = 0; k < activeRooms.size(); k++) {
+        if (results) results->append(roomEvents[k]);
+        else roomEvents[k].clear();
+
+        answerRiddles(activeRooms[k], roomRiddles[k]);
+        roomRiddles[k].clear();
+
+        for (int i = 0; i < numPlayers; i++) {
+            if (playerRoom[i] != activeRooms[k] || pendingRoom[i] == -1)
+                continue;
+
+            int dest = pendingRoom[i];
+            pendingRoom[i] = -1;
+            moveRoom(players[i], dest);
+            moved = true;
+        }
     }
+
+    if (moved)
+        trimRooms();        // rooms players left behind may be unloaded
 }
 
 bool GameBase::processKey(char choice) {
-    for (PlayerID id : {PLAYER_1, PLAYER_2}) {
-        // Dispose keys (collectibles)
-        if (players[id].isDisposeKey(choice)) {
-            handleDispose(players[id]);
+    for (int id = 0; id < numPlayers; id++) {
+        if (processPlayerKey(id, choice))
             return true;
-        }
+    }
+    return false;
+}
 
-        // Movement keys
-        if (players[id].isMoveKey(choice)) {
-            players[id].setDir(choice);
-            return true;
-        }
+bool GameBase::processPlayerKey(int id, char choice) {
+    // Dispose keys (collectibles)
+    if (players[id].isDisposeKey(choice)) {
+        handleDispose(players[id]);
+        return true;
+    }
+
+    // Movement keys
+    if (players[id].isMoveKey(choice)) {
+        players[id].setDir(choice);
+        return true;
     }
     return false;
 }
 
 // Init Functions
 void GameBase::initGame() {
-    Utils::hideCursor();
+    if (!hosted)
+        Utils::hideCursor();
+    roomLoader.reset(0);        // no background load may be writing into a room that goes away
     screens.clear();
+    snapshots.clear();
     // --- Set global game state ---
     gameOver = false;
     currRoomID = ROOM1_SCREEN;
+    panes.clear();
+    timers.clear();
 
     // Set player progress
-    roomsDone[PLAYER_1] = roomsDone[PLAYER_2] = 0;
-    playerRoom[PLAYER_1] = playerRoom[PLAYER_2] = ROOM1_SCREEN;
-    playerFinished[PLAYER_1] = playerFinished[PLAYER_2] = false;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        roomsDone[i] = 0;
+        playerRoom[i] = ROOM1_SCREEN;
+        playerFinished[i] = false;
+    }
 
     // --- 
-    // players ---
-    constexpr char keys1[] = { 'D','X','A','W','S','E' };
-    constexpr char keys2[] = { 'L','M','J','I','K','O' };
-
-    players[PLAYER_1].setPlayer(Point(3, 9), '$', keys1);
-    players[PLAYER_2].setPlayer(Point(3, 11), '&', keys2);
+    // players (may be replaced by the players file when the game files are loaded) ---
+    numPlayers = DEFAULT_PLAYERS;
+    players[PLAYER_1].setPlayer(playerStartPos(PLAYER_1), '$', DEFAULT_PLAYER_KEYS[PLAYER_1]);
+    players[PLAYER_2].setPlayer(playerStartPos(PLAYER_2), '&', DEFAULT_PLAYER_KEYS[PLAYER_2]);
 }
 
 bool GameBase::loadGameFiles() {  // *Developed with AI assistance*
 
+    // Players come first - their number decides the legend size of every room
+    if (!loadPlayers()) return false;
+
+    // A manifest lists the rooms of a large world, in room order
     std::vector<std::string> foundFiles;
+    if (!loadManifest(foundFiles)) return false;
+    bool numbered = foundFiles.empty();
     char filenameBuffer[50];
 
-    // --- Find all level files ---
-    for (int i = 1; i <= MAX_ROOMS_CAPACITY; ++i)
+    // --- Otherwise find all numbered level files ---
+    for (int i = 1; numbered && i <= MAX_NUMBERED_ROOMS; ++i)
     {
         snprintf(filenameBuffer, sizeof(filenameBuffer), "adv-world_%02d.screen", i);
         std::ifstream fileCheck(filenameBuffer);
@@ -238,8 +517,9 @@ bool GameBase::loadGameFiles() {  // *Developed with AI assistance*
         return false;
     }
 
-    // Ensure rooms are loaded in lexicographical order
-     std::sort(foundFiles.begin(), foundFiles.end());
+    // Ensure numbered rooms are loaded in lexicographical order
+    if (numbered)
+        std::sort(foundFiles.begin(), foundFiles.end());
 
      // Initialize screens from the discovered files
     if (!initGameFiles(foundFiles)) return false;
@@ -247,112 +527,289 @@ bool GameBase::loadGameFiles() {  // *Developed with AI assistance*
     return true;
 }
 
-bool GameBase::initGameFiles(const std::vector<std::string>& foundFiles)
-{
-    screens.clear();
-    screens.resize(foundFiles.size() + 2);      // +2: index 0 unused, last index reserved for final room
-    // Load each screen file
-    for (size_t i = 0; i < foundFiles.size(); ++i)
-    {
-        std::string errorMsg, warningMsg;
+// Reads the optional world manifest: one screen file per line (room 1 first), # starts a comment.
+// Every listed file must exist - rooms themselves are only read when first entered
+bool GameBase::loadManifest(std::vector<std::string>& files) {
+    MappedFile file;
+    if (!file.open(WORLD_MANIFEST))
+        return true;
+
+    TextScanner text = file.lines();
+    LineCursor line;
+    TextView name;
 
-        bool success = screens[i + 1].loadScreenFromFile( foundFiles[i], errorMsg, warningMsg );
+    while (text.nextLine(line)) {
+        if (!line.readWord(name) || name[0] == '#') continue;
 
-        if (!success) {
-            showError(errorMsg);
+        if (!std::ifstream(name.str()).good()) {
+            showError(std::string(WORLD_MANIFEST) + " line " + std::to_string(line.line()) +
+                ":\ncannot find " + name.str());
             return false;
         }
-        // Non-fatal warnings are shown immediately
-        if (!warningMsg.empty())
-            showMessage(warningMsg);
+        files.push_back(name.str());
     }
 
-    if (!loadRiddles()) return false;
-
-    int numRooms = static_cast<int>(foundFiles.size());  // number of real rooms (excluding dummy)
-
-    for (size_t i = 1; i < screens.size(); ++i) {
-        std::string errorMsg;
+    if (files.empty()) {
+        showError(std::string(WORLD_MANIFEST) + ":\nno rooms listed");
+        return false;
+    }
+    return true;
+}
 
-        // Validate doors
-        if (!screens[i].validateDoors(numRooms, errorMsg)) {
-            showError(errorMsg);
+// Rooms are loaded the first time a player enters them (see RoomLoader.h) - only the first room is
+// loaded here, so the first frame doesn't wait for the whole world. The rooms its doors lead to
+// are loaded in the background meanwhile.
+bool GameBase::initGameFiles(const std::vector<std::string>& foundFiles)
+{
+    roomLoader.reset(0);
+    wholeWorld = false;
+    screens.clear();
+    screens.resize(foundFiles.size() + 2);      // +2: index 0 unused, last index reserved for final room
+    startCells.assign(screens.size(), OccupancyGrid());
+    liveCells.assign(screens.size(), OccupancyGrid());
+    claimCells.assign(screens.size(), OccupancyGrid());
+
+    numRooms = static_cast<int>(foundFiles.size());  // number of real rooms (excluding dummy)
+    roomFiles.assign(screens.size(), std::string());
+    snapshots.assign(screens.size(), RoomSnapshot());
+    std::copy(foundFiles.begin(), foundFiles.end(), roomFiles.begin() + 1);
+
+    // A room is known by its content - in recordings and in the room cache
+    roomHashes.assign(screens.size(), 0);
+    for (int roomID = ROOM1_SCREEN; roomID <= numRooms; roomID++) {
+        if (!ScreenId::hashFile(roomFiles[roomID], roomHashes[roomID])) {
+            showError("Cannot read screen file " + roomFiles[roomID]);
             return false;
         }
+    }
 
-        // Validate legend placement
-        if (!screens[i].validateLegendPlacement(errorMsg)) {
-            showError(errorMsg);
-            return false;
-        }
+    // Cheap checks of the whole world stay upfront
+    if (!loadRiddles()) return false;
 
-        // Remove legend area from the playable board
-        screens[i].clearLegendAreaFromBoard();
-    }
+    roomLoader.reset(static_cast<int>(screens.size()));
 
     // Create and append the final screen
     int finalIndex = static_cast<int>(foundFiles.size()) + 1;
     screens[finalIndex].setMap(FINAL_MAP);
+    roomLoader.markReady(finalIndex);
 
     // Set initial room
     currRoomID = ROOM1_SCREEN;     // Set initial room
+    if (!ensureRoom(ROOM1_SCREEN)) return false;
+    prefetchFrom(ROOM1_SCREEN);
     return true;
 }
 
-bool GameBase::loadRiddles() {
-    std::ifstream file("riddles.txt");
-    if (!file.is_open()) {
-        showError("Cannot load riddles file");
+// Loads a room from its screen file, with its riddles - or brings an unloaded room back as it was
+// left. Only touches screens[roomID], so it may run on the loader's thread while the game goes on
+bool GameBase::loadRoom(int roomID, std::string& errorMsg, std::string& warningMsg)
+{
+    Screen& room = screens[roomID];
+    if (!snapshots[roomID].empty()) {
+        snapshots[roomID].restore(room);
+        return true;
+    }
+    room.setLegendRows(legendHeight(numPlayers));
+
+    // This or an earlier game of the process may have parsed the same room already (see RoomCache.h)
+    RoomKey cacheKey{ roomHashes[roomID], riddles->getHash(), roomID, numRooms, numPlayers };
+    if (RoomCache::shared().find(cacheKey, room, warningMsg))
+        return true;
+
+    if (!room.loadScreenFromFile(roomFiles[roomID], errorMsg, warningMsg))
+        return false;
+    // (legend placement is checked and cleared from the board while the screen loads)
+    if (!room.validateDoors(numRooms, errorMsg))
+        return false;
+    if (!loadRiddles(roomID, errorMsg))
+        return false;
+
+    RoomCache::shared().add(cacheKey, room, warningMsg);
+    return true;
+}
+
+bool GameBase::ensureRoom(int roomID) {
+    std::string errorMsg, warningMsg;
+    if (!roomLoader.ensure(roomID, errorMsg, warningMsg)) {
+        showError(errorMsg);
         return false;
     }
+    // Non-fatal warnings are shown when the room is first used
+    if (!warningMsg.empty())
+        showMessage(warningMsg);
+    return true;
+}
 
-    int roomID, x, y;
-    std::string question, answer, dummy; //dummy for spaces
+// Snapshots the room and frees its per-cell grids - they are sized again when it is next marked
+void GameBase::unloadRoom(int roomID) {
+    snapshots[roomID].take(screens[roomID]);
+    startCells[roomID] = OccupancyGrid();
+    liveCells[roomID] = OccupancyGrid();
+    claimCells[roomID] = OccupancyGrid();
+}
 
-    while (file >> roomID >> x >> y) {
-        std::getline(file, dummy);
-        std::getline(file, question);
-        std::getline(file, answer);
-        Riddle* r = screens[roomID].getRiddleAt(Point(x, y));
+void GameBase::prefetchFrom(int roomID) {
+    if (hosted)                 // no loader thread per game - and a cached room is a copy away
+        return;
+    for (int dest : screens[roomID].getDestinations())
+        roomLoader.prefetch(dest);
+}
 
-        if (!r) {
-            showError("Rule refers to non-existing riddle in room " + std::to_string(roomID) +
-                " at (" + std::to_string(x) + "," + std::to_string(y) + ")");
+// Keeps at most RESIDENT_ROOMS rooms loaded, so memory doesn't grow with the world. A room stays
+// while a player is in it or next to it (a door away), while it is shown and while its timers run -
+// nothing outside a room refers to it otherwise, so the rest can be snapshotted
+void GameBase::trimRooms() {
+    if (wholeWorld)
+        return;
+    std::vector<bool> keep(screens.size(), false);
+    keep[screens.size() - 1] = true;        // final room
+    keep[currRoomID] = true;
+
+    for (int i = 0; i < numPlayers; i++) {
+        if (playerFinished[i]) continue;
+        keep[playerRoom[i]] = true;
+        for (int dest : screens[playerRoom[i]].getDestinations())
+            keep[dest] = true;
+    }
+
+    roomLoader.trim(RESIDENT_ROOMS, [&](int roomID) { return keep[roomID] || timers.hasRoom(roomID); });
+}
+
+void GameBase::host() {
+    hosted = true;
+    frame.detach();
+}
+
+// A network game goes back in time (see GameSave.h) - every room must be there, as it was
+bool GameBase::loadWholeWorld() {
+    for (int roomID = ROOM1_SCREEN; roomID <= numRooms; roomID++) {
+        if (!ensureRoom(roomID))
             return false;
+    }
+    wholeWorld = true;
+    return true;
+}
+
+void GameBase::saveState(GameSave& save, const GameSave* previous) const {
+    save.tick = gameCycles + 1;
+    save.hash = stateHash();
+    std::copy(players, players + numPlayers, save.players);
+    std::copy(playerRoom, playerRoom + numPlayers, save.playerRoom);
+    std::copy(roomsDone, roomsDone + numPlayers, save.roomsDone);
+    std::copy(playerFinished, playerFinished + numPlayers, save.playerFinished);
+    save.currRoomID = currRoomID;
+    save.gameOver = gameOver;
+    save.timers.copyFrom(timers);
+
+    // Only a room with a player or a timer in it can change during the tick
+    std::vector<bool> busy(screens.size(), false);
+    for (int i = 0; i < numPlayers; i++)
+        busy[playerRoom[i]] = true;     // a finished player may still dispose
+
+    save.rooms.resize(screens.size());
+    save.copied.assign(screens.size(), false);
+    for (size_t roomID = 0; roomID < screens.size(); roomID++) {
+        if (previous && !busy[roomID] && !timers.hasRoom(static_cast<int>(roomID))) {
+            save.rooms[roomID] = previous->rooms[roomID];
+            continue;
         }
+        std::shared_ptr<Screen> copy = std::make_shared<Screen>();
+        copy->copyFrom(screens[roomID]);
+        save.rooms[roomID] = copy;
+        save.copied[roomID] = true;
+    }
+}
 
-        r->setData(question, answer);
+void GameBase::loadState(const GameSave& save, const std::vector<bool>& changedRooms) {
+    gameCycles = save.tick - 1;
+    std::copy(save.players, save.players + numPlayers, players);
+    std::copy(save.playerRoom, save.playerRoom + numPlayers, playerRoom);
+    std::copy(save.roomsDone, save.roomsDone + numPlayers, roomsDone);
+    std::copy(save.playerFinished, save.playerFinished + numPlayers, playerFinished);
+    currRoomID = save.currRoomID;
+    gameOver = save.gameOver;
+    timers.copyFrom(save.timers);
+
+    for (size_t roomID = 0; roomID < screens.size(); roomID++) {
+        if (changedRooms[roomID])
+            screens[roomID].copyFrom(*save.rooms[roomID]);
     }
-    file.close();
-    return true;
 }
 
-bool GameBase::loadRiddles(int loadRoomID) {
-    std::ifstream file("riddles.txt");
-    if (!file.is_open()) {
-        showError("Cannot load riddles file");
+// Reads the riddles file once, before any room is loaded - every entry is well formed and names a
+// room. Rooms take their riddles from the store from then on (see RiddleStore.h)
+bool GameBase::loadRiddles() {
+    std::string errorMsg;
+    riddles = RiddleStore::load(RIDDLES_FILE, errorMsg);
+    if (!riddles || !riddles->checkRooms(numRooms, errorMsg)) {
+        riddles.reset();
+        showError(errorMsg);
         return false;
     }
+    return true;
+}
+
+// Gives the riddles of a (just loaded) room their question and answers
+bool GameBase::loadRiddles(int loadRoomID, std::string& errorMsg) {
+    Screen& room = screens[loadRoomID];
+    return riddles->forRoom(loadRoomID, [&](const Point& pos, const std::shared_ptr<const RiddleText>& text) {
+        Riddle* r = room.getRiddleAt(pos);
+        if (!r) {
+            errorMsg = "Rule refers to non-existing riddle in room " + std::to_string(loadRoomID) +
+                " at (" + std::to_string(pos.getX()) + "," + std::to_string(pos.getY()) + ")";
+            return false;
+        }
+        r->setData(text);
+        return true;
+    });
+}
 
-    int roomID, x, y;
-    std::string question, answer, dummy; //dummy for spaces
+// Reads the optional players file. Each line: <figure> <keys>, keys in the order
+// RIGHT DOWN LEFT UP STAY DISPOSE (e.g. "$ DXAWSE"). Without the file the default two players play.
+bool GameBase::loadPlayers() {
+    MappedFile file;
+    if (!file.open(PLAYERS_FILE))
+        return true;
 
-    while (file >> roomID >> x >> y) {
-        std::getline(file, dummy);
-        std::getline(file, question);
-        std::getline(file, answer);
-        if (roomID != loadRoomID) continue;
-        Riddle* r = screens[roomID].getRiddleAt(Point(x, y));
+    TextScanner text = file.lines();
+    LineCursor line;
+    std::string usedKeys = { HOME, RESTART };   // keys that already have a meaning
+    int count = 0;
 
-        if (!r) {
-            Riddle newRiddle(Point(x, y));
-            newRiddle.setData(question, answer);
-            screens[roomID].addRiddle(newRiddle);
+    while (text.nextLine(line)) {
+        if (line.text().empty() || line.text()[0] == '#') continue;
+
+        TextView figure, keyView;
+        std::string where = std::string(PLAYERS_FILE) + " line " + std::to_string(line.line());
+
+        if (!(line.readWord(figure) && line.readWord(keyView)) || figure.size != 1 || keyView.size != NUM_PLAYER_KEYS) {
+            showError(where + ":\nexpected <figure> <" + std::to_string(NUM_PLAYER_KEYS) + " keys>");
+            return false;
         }
-        else
-            r->setData(question, answer);
+        if (count == MAX_PLAYERS) {
+            showError(std::string(PLAYERS_FILE) + ":\nmore than " + std::to_string(MAX_PLAYERS) + " players");
+            return false;
+        }
+
+        std::string keys = Utils::toUpperCase(keyView.str());
+        for (char k : keys) {
+            if (usedKeys.find(k) != std::string::npos) {
+                showError(where + ":\nkey '" + std::string(1, k) + "' is already in use");
+                return false;
+            }
+            usedKeys += k;
+        }
+
+        players[count].setPlayer(playerStartPos(count), figure[0], keys.c_str());
+        count++;
     }
-    file.close();
+
+    if (count == 0) {
+        showError(std::string(PLAYERS_FILE) + ":\nno players defined");
+        return false;
+    }
+
+    numPlayers = count;
     return true;
 }
 
@@ -363,13 +820,16 @@ bool GameBase::restartCurrentRoom() {
 
     // Clear current room state
     screens[currRoomID].clearRoom();
+    timers.cancelRoom(currRoomID);
     // Reload room from original file
     if (!reloadRoom(currRoomID)) return false;
 
     // Reset players that are currently in this room
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        if (playerRoom[i] == currRoomID)
+    for (int i = 0; i < numPlayers; ++i) {
+        if (playerRoom[i] == currRoomID) {
+            cancelPlayerTimers(players[i]);
             players[i].resetForRoom();
+        }
     }
     return true;
 }
@@ -380,48 +840,30 @@ bool GameBase::reloadRoom(int roomID) {
         return false;
 
     std::string error, warning;
-    const std::string& filename = screens[roomID].getSourceFile();
     // Room has no associated file (e.g., final room)
-    if (filename.empty()) {
+    if (roomFiles[roomID].empty()) {
         showError("Restarting room failed");
         return false;
     }
-    // Reload screen from file
-    if (!screens[roomID].loadScreenFromFile(filename, error, warning)) {
-        showError(error);
-        return false;
-    }
-
-    if (!loadRiddles(roomID))
-        return false;
-
-    if (!screens[roomID].validateLegendPlacement(error)) {
+    // Reload screen (and its riddles) from file
+    if (!loadRoom(roomID, error, warning)) {
         showError(error);
         return false;
     }
-
-    screens[roomID].clearLegendAreaFromBoard();
     return true;
 }
 
 void GameBase::showError(const std::string& msg){
     Utils::clearScreen();
 
-    std::string line1, line2;
-    bool foundNewline = false;
-
+    // One row per line of the message (a map with several errors lists them all)
+    std::vector<std::string> lines(1);
     for (size_t i = 0; i < msg.length(); i++)
     {
         if (msg[i] == '\n')
-        {
-            foundNewline = true;
-            continue;
-        }
-
-        if (!foundNewline)
-            line1 += msg[i];
+            lines.emplace_back();
         else
-            line2 += msg[i];
+            lines.back() += msg[i];
     }
 
     std::string errorTitle = "ERROR:";
@@ -429,15 +871,11 @@ void GameBase::showError(const std::string& msg){
     Utils::gotoxy(static_cast<int>(xError), 10);
     std::cout << errorTitle;
 
-    int xLine1 = (SCREEN_WIDTH - line1.length()) / 2;
-    Utils::gotoxy(xLine1, 12);
-    std::cout << line1;
-
-    if (!line2.empty())
+    for (size_t i = 0; i < lines.size() && 12 + i < 17; i++)
     {
-        int xLine2 = (SCREEN_WIDTH - line2.length()) / 2;
-        Utils::gotoxy(xLine2, 13);
-        std::cout << line2;
+        int xLine = (SCREEN_WIDTH - lines[i].length()) / 2;
+        Utils::gotoxy(xLine, static_cast<int>(12 + i));
+        std::cout << lines[i];
     }
 
     std::string pressKey = "Press any key to continue ";
@@ -488,28 +926,27 @@ void GameBase::showMessage(const std::string& msg) {
 // Helper Functions
 
 void GameBase::moveRoom(Player& player, int dest) {
-    int idx = (&player == &players[PLAYER_1]) ? PLAYER_1 : PLAYER_2;      // determine which player is moving
-
-    int other = 1 - idx;                             // index of the other player
+    int idx = indexOf(player);      // determine which player is moving
+    roomLoader.touch(playerRoom[idx]);   // the room left behind was in use until now
 
     // --- Final Room Logic ---
     if (isFinalRoom(dest)) {
         Point startP = getStartPoint(player, idx, dest);   // starting position inside the final screen
+        bool first = !isGameInFinalPhase();                 // nobody finished before this player
 
         playerRoom[idx] = dest;      // mark this player in the final screen
         playerFinished[idx] = true;          // player reached the final room
 
         player.setStartPos(startP);
+        player.addScore(scoreValue(first ? ScoreEvent::FinishGameFirst : ScoreEvent::FinishGameSecond));
 
-        // According to the rules: if only one player is finished,
-        // we return to the second player
-        if (!playerFinished[other]) {
-            currRoomID = playerRoom[other];
-            player.addScore(scoreValue(ScoreEvent::FinishGameFirst));
+        // According to the rules: while some players are still playing,
+        // we return to the one who is furthest behind
+        if (!allPlayersFinished()) {
+            currRoomID = playerRoom[trailingPlayer(idx)];
         }
-        else {    // both players are in the final room
+        else {    // all players are in the final room
             currRoomID = dest;        
-            player.addScore(scoreValue(ScoreEvent::FinishGameSecond));
             gameOver = true;
         }
 
@@ -519,6 +956,10 @@ void GameBase::moveRoom(Player& player, int dest) {
     }
 
     // --- Regular Room Transition ---
+    if (!ensureRoom(dest)) {                   // first entry - the room may not be loaded yet
+        isRunning = false;
+        return;
+    }
     roomsDone[idx]++;                          // player completed one more room
     player.clearInventory();
 
@@ -530,14 +971,22 @@ void GameBase::moveRoom(Player& player, int dest) {
     if (results) { results->addScreenChange(gameCycles, dest); }   
 
     // decide which room should currently be displayed:
-    if (roomsDone[PLAYER_1] < roomsDone[PLAYER_2])
-        currRoomID = playerRoom[PLAYER_1];       // player 1 is behind
+    currRoomID = playerRoom[trailingPlayer(idx)];
+
+    prefetchFrom(dest);                        // the rooms the player may go next
+}
 
-    else if (roomsDone[PLAYER_2] < roomsDone[PLAYER_1])
-        currRoomID = playerRoom[PLAYER_2];       // player 2 is behind
+// Returns the unfinished player who completed the fewest rooms.
+// On equal progress the moving player (idx) wins, so the camera follows it.
+int GameBase::trailingPlayer(int idx) const {
+    int behind = playerFinished[idx] ? -1 : idx;
 
-    else
-        currRoomID = playerRoom[idx];     // same progress - follow the moving player
+    for (int i = 0; i < numPlayers; i++) {
+        if (playerFinished[i]) continue;
+        if (behind == -1 || roomsDone[i] < roomsDone[behind])
+            behind = i;
+    }
+    return behind == -1 ? idx : behind;
 }
 
 // Calculates the player's starting position in the next room based on the door's position
@@ -547,15 +996,16 @@ Point GameBase::getStartPoint(Player& player, int idx, int dest) const {
    Point posOnDoor = player.getPos();      // player is standing on the door
 
    int startY = posOnDoor.getY();          // keep same row as the door
-   int startX = (idx == 0?1:2);            // player 0 and 1 don't get the same point
+   int startX = 1 + idx;                   // players don't get the same point
 
    const Point startPos(startX, startY);
+   const BoardSize& size = room.getSize();    // rooms may differ in size - the door's row may not exist
 
-   if (!room.isLegendCell(startPos) && room.charAt(startPos) == ' ')   // if cell is clear
+   if (size.contains(startPos) && !room.isLegendCell(startPos) && room.charAt(startPos) == ' ')   // if cell is clear
        return startPos;
 
-   for (int y = 1; y < SCREEN_HEIGHT; y++) {
-       for (int x = 1; x < SCREEN_WIDTH; x++) {
+   for (int y = 1; y < size.height; y++) {
+       for (int x = 1; x < size.width; x++) {
            Point p(x, y);
            if (!room.isLegendCell(p) && room.isCellFree(p))
                return p;
@@ -564,61 +1014,23 @@ Point GameBase::getStartPoint(Player& player, int idx, int dest) const {
    return startPos;
 }
 
-// Checks if the current player and the other player are about to step into the same cell
+// Checks if the current player is about to step into a cell another player stands on.
+// Conflicts between moving players were settled before the round - whoever is still there stays.
 bool GameBase::playersCollide(int idx, const Point& nextPos) {
-    int other = 1 - idx;
-
-    // Only relevant if both players are in the same room
-    if (playerRoom[other] != playerRoom[idx]) return false;
-
-    Point otherPos = players[other].getPos();
-    Point otherNext = players[other].getNextPos();
-
-    Screen& room = screens[currRoomID];
+    // Only players of the same room are in the room's occupancy grid
+    int other = liveCells[playerRoom[idx]].at(nextPos);
 
     // No physical contact = no collision
-    if (nextPos != otherPos) return false;
-
-    Direction myDir = players[idx].getDir();
-    Direction otherDir = players[other].getDir();
-    bool otherBlocked = (otherNext != otherPos);    // true if other is blocked by an object
-
-    // Case 1: other player in stay mode = collision
-    if (otherDir == STAY) {
-        players[idx].bumpedInto(players[other]);
-        return true;
-    }
-
-    // Case 2: head-on collision (opposite directions)
-    if (Point::areOpposite(myDir, otherDir)) {
-        players[idx].bumpedInto(players[other]);
-        return true;
-    }
-
-    // Case 3: other player is blocked
-    if (otherBlocked) {
-        players[idx].bumpedInto(players[other]);
-        bool blockedByObstacle = room.isObstacle(otherNext);
-        if (blockedByObstacle) {
-            if (chainPushSuccess(idx, myDir, otherNext)) {
-                players[idx].setPushing(true);
-                return false;
-            }
-            return true;
-        }
-
-        players[idx].bumpedInto(players[other]);
-        return true;    // collision
-    }
+    if (other == -1 || other == idx) return false;
 
-    // Otherwise: same direction (chasing) = no collision
-    return false;
+    bump(idx, other);
+    return true;
 }
 
 // Handle Functions
 
 void GameBase::handleDoor(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point p = player.getPos();
 
     if (!room.isDoor(p)) return;   // no door at this cell
@@ -626,8 +1038,8 @@ void GameBase::handleDoor(Player& player) {
     Door* d = room.getDoorAt(p);        // get door object
     int dest = d->getDestination();
 
-    if (d->checkIsOpen()) {    // if door is already open move room immediately
-        moveRoom(player, dest);
+    if (d->checkIsOpen()) {    // if door is already open leave the room at the end of this tick
+        pendingRoom[indexOf(player)] = dest;
         return;
     }
     else {
@@ -646,32 +1058,31 @@ void GameBase::handleDoor(Player& player) {
 
     if (d->getKeyStatus() && d->getSwitchStatus()) {
         d->open();
-        moveRoom(player, dest);
+        pendingRoom[indexOf(player)] = dest;
     }
 }
 
 void GameBase::handleSwitch(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point p = player.getPos();
 
     if (!room.isSwitch(p)) return;  // no switch at this cell
 
-    Switch* sw = room.getSwitchAt(p);
-    sw->toggle();
+    Switch* sw = room.toggleSwitchAt(p);
 
     // Update switch character on screen
     char c = room.charAt(p);
     room.erase(p);
     char fig = (c == '/' ? 'o' : '/');
-    room.drawChar(p, fig);
+    room.setChar(p, fig);
 
     int id = sw->getDoorID();
-    updateDoorBySwitches(id);
+    updateDoorBySwitches(room, id);
 }
 
 // *Logic reviewed with ChatGPT assistance*
 bool GameBase::handleSprings(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point next = player.getPos().next(player.getDir());
 
     // Check spring on target cell
@@ -684,7 +1095,7 @@ bool GameBase::handleSprings(Player& player) {
             return false;
 
         // Player has started compression but changed their direction -> find the spring they were compressing
-        Spring* adj = findAdjacentSpring(player.getPos());
+        Spring* adj = findAdjacentSpring(room, player.getPos());
 
         if (!adj) {
             // No spring found nearby fail safely
@@ -711,7 +1122,7 @@ bool GameBase::handleSprings(Player& player) {
         // Player is moving into the spring
         if (player.isAccelerating())
             // If player is accelerating from another spring (reset accel)
-            player.stopAcceleration();
+            stopAcceleration(player);
 
         if (compressSpring(player, *sp)) {
             // curr size > 0 still
@@ -726,56 +1137,82 @@ bool GameBase::handleSprings(Player& player) {
     return false; // no special spring handling
 }
 
-void GameBase::handleBombs() {
-    //Updates bomb timers in the current room and triggers explosions
-    Screen& room = screens[currRoomID];
-    std::vector<Bomb>& bombs = room.getBombs();
-    std::vector<Point> toExplode;
-
-    // Check which bombs are ready to explode
-    for (auto& bomb : bombs) {
-        if (bomb.tick())
-            toExplode.push_back(bomb.getPos());
+void GameBase::handleTimers() {
+    // Advances the timer wheel by one tick and handles every timer that expired, in any room
+    timers.advance(expiredTimers);
+
+    for (const TimerEvent& ev : expiredTimers) {
+        switch (ev.type) {
+        case TimerType::BombExplode: {
+            // The bomb may have been destroyed by another blast or the room restarted meanwhile
+            Bomb* b = screens[ev.roomID].getStoredBomb(ev.entity);
+            if (b && b->isTicking() && b->getFuse() == ev.handle)
+                explodeBomb(ev.roomID, b->getPos());
+            break;
+        }
+        case TimerType::PlayerRespawn:
+            if (players[ev.owner].getRespawnTimer() == ev.handle)
+                players[ev.owner].respawn();
+            break;
+        case TimerType::AccelEnd:
+            if (players[ev.owner].getAccelTimer() == ev.handle) {
+                players[ev.owner].endAcceleration();
+                players[ev.owner].getAccelTimer() = TimerHandle{};
+            }
+            break;
+        }
     }
-
-    // Explode bombs after iteration
-    for (const auto& p : toExplode)
-        explodeBomb(p);
 }
 
+// A riddle ahead stops the player for this tick - it is asked once every room ran (see answerRiddles)
 bool GameBase::handleRiddles(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     const Point& nextPos = player.getNextPos();
 
-    Riddle* r = room.getRiddleAt(nextPos);
-    if (r == nullptr) {
+    if (room.getRiddleAt(nextPos) == nullptr) {
         return true;
     }
-    bool solved = false;
+    stagedRiddles->push_back({ indexOf(player), nextPos });
+    return false;
+}
 
-    // Virtual call - subclasses can override
-    if (!getRiddleAnswer(r, solved)) {
-        return false;
-    }
+// Asks the riddles the room's players stepped at this tick, in the order they came up, on the game's
+// own thread. A solved riddle lets its player take the step it held up
+void GameBase::answerRiddles(int roomID, const std::vector<RiddleEncounter>& riddles) {
+    Screen& room = screens[roomID];
 
-    if (solved) {
-        room.removeRiddleAt(nextPos);
-        room.erase(nextPos);
+    for (const RiddleEncounter& encounter : riddles) {
+        Player& player = players[encounter.player];
+        Riddle* r = room.getRiddleAt(encounter.pos);
+        if (r == nullptr)
+            continue;       // another player solved it and stands there now
+
+        // Virtual call - subclasses can override (may ask the user)
+        bool solved = false;
+        if (!getRiddleAnswer(r, encounter.player, solved) || !solved) {
+            player.setDirection(STAY);
+            continue;
+        }
+
+        room.removeRiddleAt(encounter.pos);
+        room.erase(encounter.pos);
         player.addScore(scoreValue(ScoreEvent::SolveRiddle));
-    }
 
-    return solved;
+        liveCells[roomID].remove(player.getPos(), encounter.player);
+        player.setPos(encounter.pos);
+        liveCells[roomID].set(encounter.pos, encounter.player);
+    }
 }
 
 void GameBase::handleTorch(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
 
     if (player.checkItem() == TORCH)
         room.illuminateMap(player.getPos());
 }
 
 bool GameBase::handleObstacles(Player& player, const Point& nextPos) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point p = nextPos;
 
     // no obstacle at this cell - player can continue moving
@@ -789,8 +1226,7 @@ bool GameBase::handleObstacles(Player& player, const Point& nextPos) {
 
     if (!ob->canBePushed(force)) return true; // too weak - stop
 
-    auto nextBody = ob->getNextBody(dir);
-    if (!canMoveObstacle(nextBody, ob)) return true; // obstacle blocking the way
+    if (!canMoveObstacle(playerRoom[indexOf(player)], *ob, dir)) return true; // obstacle blocking the way
 
     room.pushObstacle(*ob, dir);
     player.setPos(p);
@@ -798,7 +1234,7 @@ bool GameBase::handleObstacles(Player& player, const Point& nextPos) {
 }
 
 void GameBase::handleCollectibles(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point p = player.getPos();
 
     // Player already holds an item cannot pick up another
@@ -814,7 +1250,7 @@ void GameBase::handleCollectibles(Player& player) {
 }
 
 bool GameBase::handleTeleports(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
     Point currentPos = player.getPos();
     if (currentPos == player.getTeleportPos()) {
         player.setTeleportPos({ -1, -1 });
@@ -831,7 +1267,7 @@ bool GameBase::handleTeleports(Player& player) {
 }
 
 bool GameBase::handleDispose(Player& player) {
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
 
     if (player.inventoryEmpty()) return false;
 
@@ -840,36 +1276,45 @@ bool GameBase::handleDispose(Player& player) {
     if (room.charAt(p) != ' ') return false;  // Cannot place an item on an occupied cell
 
     const ItemType& type = player.checkItem();
-    int index = player.getIndex();
+    EntityHandle handle = player.getItemHandle();
 
     switch (type) {
         case KEY: {
             // Take key from storage, place it on the board, and activate it
-            Key& k = room.getStoredKey(index);
-            k.setPos(p);
+            Key* k = room.getStoredKey(handle);
             player.clearInventory();
+            if (!k) break;          // the key was destroyed while carried
+            k->setPos(p);
             player.setDisposeFlag(true);
-            k.activate();
+            k->activate();
             break;
         }
         case BOMB: {
             // Take bomb from storage and arm it at the player's position
-            Bomb& b = room.getStoredBomb(index);
+            Bomb* b = room.getStoredBomb(handle);
             player.clearInventory();
+            if (!b) break;
             player.setDisposeFlag(true);
-            b.arm(p);
+
+            TimerEvent fuse;
+            fuse.type = TimerType::BombExplode;
+            fuse.roomID = playerRoom[indexOf(player)];
+            fuse.entity = handle;
+            b->arm(p, timers.schedule(BOMB_FUSE_TICKS, fuse));
             break;
         }
         case TORCH: {
-            Torch& t = room.getStoredTorch(index);
-            t.setPos(p);
+            Torch* t = room.getStoredTorch(handle);
             player.clearInventory();
+            if (!t) break;
+            t->setPos(p);
             player.setDisposeFlag(true);
-            t.activate();
+            t->activate();
             break;
         }
         default: break;
     }
+    room.refreshStored(type, handle);   // the item is shown again at its new position
     return true;
 }
 
@@ -882,8 +1327,6 @@ bool GameBase::handleAcceleratedMovement(Player& player, int index)
     int count = player.getAccelerationSubSteps(sub);
 
     for (int k = 0; k < count; k++) {
-        player.setPushing(false);
-
         Point nextPos = sub[k];
 
         if (room.isLegendCell(nextPos)) return true;
@@ -891,7 +1334,7 @@ bool GameBase::handleAcceleratedMovement(Player& player, int index)
         if (!room.isCellFree(nextPos)) {
             // If player's in acceleration, wall stops it
             if (player.isAccelerating())
-                player.stopAcceleration();
+                stopAcceleration(player);
             break;
         }
 
@@ -902,31 +1345,24 @@ bool GameBase::handleAcceleratedMovement(Player& player, int index)
 
         if (handleObstacles(player, nextPos)) return true;
 
-        if (!handleRiddles(player)) {
-            player.setDirection(STAY);
-            return true;
-        }
+        if (!handleRiddles(player)) return true;
 
         // wall collision stops acceleration
         if (!room.isCellFree(nextPos)){
-            player.stopAcceleration();
+            stopAcceleration(player);
             return true;
         }
 
         // player collision
         if (playersCollide(index, nextPos)) return true;
 
-        if (player.isPushing()){
-            player.setPos(nextPos);
-            break;
-        }
         player.setPos(nextPos);          // commit movement
         handleCollectibles(player);   // collect items mid-flight
         handleSwitch(player);         // toggle switch mid-flight
         handleDoor(player);
 
-        // if moved rooms or died stop movement now
-        if (playerRoom[index] != currRoomID || player.getDead())
+        // if leaving the room or died stop movement now
+        if (pendingRoom[index] != -1 || player.getDead())
             return true;
     }
     return false;   // completed accelerated steps normally
@@ -936,16 +1372,15 @@ bool GameBase::handleAcceleratedMovement(Player& player, int index)
 bool GameBase::isMatchingKey(const Player& player, Screen& room, const Door* door) {
     if (player.checkItem() != KEY) return false;     // player doesn't hold a key
 
-    int keyIndex = player.getIndex();                // get access to key object
-    const Key& k = room.getStoredKey(keyIndex);
+    const Key* k = room.getStoredKey(player.getItemHandle());   // get access to key object
+    if (!k) return false;                            // key no longer exists
 
     // compare key's doorID to the door's doorID (not destination room)
-    return k.getDoorID() == door->getDoorID();
+    return k->getDoorID() == door->getDoorID();
 }
 
-void GameBase::updateDoorBySwitches(int id)
+void GameBase::updateDoorBySwitches(Screen& room, int id)
 {
-    Screen& room = screens[currRoomID];
     Door& d = room.getDoorById(id);
 
     const auto& switches = room.getSwitches();
@@ -968,8 +1403,8 @@ void GameBase::updateDoorBySwitches(int id)
         d.updateSwitchOK(countOn == 0);
 }
 
-void GameBase::explodeBomb(Point center) {
-    Screen& room = screens[currRoomID];    // *Developed with ChatGPT assistance*
+void GameBase::explodeBomb(int roomID, Point center) {
+    Screen& room = screens[roomID];    // *Developed with ChatGPT assistance*
     room.removeBombAt(center);
 
     // getting all points that are in the bomb explosion area
@@ -980,7 +1415,7 @@ void GameBase::explodeBomb(Point center) {
         for (size_t i = 0; i < ray.size(); i++) {
             Point p = ray[i];
 
-            if (!Point::checkLimits(p)) break; // the point and those after it in this ray are out of limits
+            if (!room.getSize().contains(p)) break; // the point and those after it in this ray are out of limits
             char c = room.charAt(p);
 
             if (c == 'W' || c == '=' || c == '|') {
@@ -989,24 +1424,22 @@ void GameBase::explodeBomb(Point center) {
                 break;
             }
             if (room.removeBombAt(p))
-                explodeBomb(p);
+                explodeBomb(roomID, p);
 
             room.removeObjectsAt(p);
 
-            for (auto& player : players) {
-                if (player.getPos() == p)
-                    applyLifeLoss(player);
+            for (int k = 0; k < numPlayers; k++) {
+                if (playerRoom[k] == roomID && players[k].getPos() == p)
+                    applyLifeLoss(players[k]);
             }
             room.erase(p);
         }
     }
 }
 
-Spring* GameBase::findAdjacentSpring(const Point& pos)
+Spring* GameBase::findAdjacentSpring(Screen& room, const Point& pos)
 {
     // Finds a spring adjacent to the given position.
-    Screen& room = screens[currRoomID];
-
     for (Direction dir : { UP, DOWN, LEFT, RIGHT}) {
         Spring* sp = room.getSpringAt(pos.next(dir));
         if (sp) return sp;
@@ -1017,7 +1450,7 @@ Spring* GameBase::findAdjacentSpring(const Point& pos)
 bool GameBase::compressSpring(Player& player, Spring& sp)
 {
     // Compresses the spring by removing its tip and updating player / spring state.
-    Screen& room = screens[currRoomID];
+    Screen& room = roomOf(player);
 
     Point tip = sp.getLinkPos(sp.getCurrSize() - 1);
     room.erase(tip);
@@ -1033,76 +1466,112 @@ void GameBase::launchPlayer(Player& player, Spring& sp)
     // Total compression force accumulated by the player
     int force = sp.springRelease();
 
+    // The links are back on the board, also while the spring is outside the view
+    Screen& room = roomOf(player);
+    for (int k = 0; k < sp.getCurrSize(); k++)
+        room.setChar(sp.getLinkPos(k), sp.getFigure());
+
     // Apply acceleration if any compression was done
-    if (force > 0)
+    if (force > 0) {
         player.accel(force, sp.getDir());   // launch in spring release direction
 
+        // acceleration lasts force^2 ticks (counting this one), then a last run of normal steps at its speed
+        TimerEvent end;
+        end.type = TimerType::AccelEnd;
+        end.owner = indexOf(player);
+        timers.cancel(player.getAccelTimer());
+        player.getAccelTimer() = timers.schedule(force * force, end);
+    }
+
     player.resetCompression();  // clear stored compression count
 }
 
-int GameBase::calcForce(const Player& pusher, const Obstacle* ob, Direction dir) const
+void GameBase::stopAcceleration(Player& player)
 {
-    int force = pusher.getSpeed();
-
-    int idx = (&pusher == &players[PLAYER_1]) ? PLAYER_1 : PLAYER_2;
-    int otherIdx = 1 - idx;
-    const Player& other = players[otherIdx];
-
-    if (playerRoom[otherIdx] != currRoomID     // must be in same room
-        || players[otherIdx].getDead()
-        || other.getDir() != dir)              // must move in same direction
-        return force;
+    // Stops forced movement before its timer expired
+    timers.cancel(player.getAccelTimer());
+    player.stopAcceleration();
+}
 
-    // use snapshot from start of step ONLY
-    Point pusherStart = prevPos[idx];
-    Point otherStart = prevPos[otherIdx];
+void GameBase::bump(int idx, int other)
+{
+    // An accelerating player passes its acceleration on - both stop at the same tick
+    if (!players[idx].bumpedInto(players[other]))
+        return;
 
-    // CASE 1: other player directly pushes the same obstacle
-    // CASE 2: chain push (other pushes pusher, pusher pushes obstacle)
-    if (ob->isObBody(otherStart.next(dir))
-        || otherStart == pusherStart.next(Point::opposite(dir)))
-        force += other.getSpeed();
+    TimerEvent end;
+    end.type = TimerType::AccelEnd;
+    end.owner = other;
+    timers.cancel(players[other].getAccelTimer());
+    players[other].getAccelTimer() = timers.scheduleAt(timers.deadlineOf(players[idx].getAccelTimer()), end);
+}
 
-    return force;
+void GameBase::cancelPlayerTimers(Player& player)
+{
+    timers.cancel(player.getAccelTimer());
+    timers.cancel(player.getRespawnTimer());
 }
 
-bool GameBase::canMoveObstacle(const std::vector<Point>& nextBody, const Obstacle* currOb)
+int GameBase::calcForce(const Player& pusher, const Obstacle* ob, Direction dir) const
 {
-    Screen& room = screens[currRoomID];
+    int idx = indexOf(pusher);
+    const OccupancyGrid& start = startCells[playerRoom[idx]];
+    Direction back = Point::opposite(dir);
 
-    for (const Point& p : nextBody) {    // Check all body cells of the obstacle
-        if (!Point::checkLimits(p)) return false;
+    // A player helps if it moves in the same direction and is alive
+    auto helps = [&](int j) {
+        return j != -1 && players[j].getDir() == dir && !players[j].getDead();
+    };
 
-        for (int i = 0; i < NUM_PLAYERS; ++i) {
-            if (playerRoom[i] != currRoomID) continue;
-            if (players[i].getPos() == p) return false;
+    // use snapshot from start of step ONLY
+    bool counted[MAX_PLAYERS] = {};
+    int line[MAX_PLAYERS];
+    int count = 0;
+
+    counted[idx] = true;
+    line[count++] = idx;
+
+    // CASE 1: other players directly push the same obstacle (standing behind its trailing edge)
+    ob->forEachTrailingCell(dir, [&](const Point& b) {
+        int j = start.at(b.next(back));
+        if (helps(j) && !counted[j]) {
+            counted[j] = true;
+            line[count++] = j;
         }
+    });
 
-        if (room.charAt(p) == ' ') continue;
-
-        if (room.isObstacle(p) && currOb->isObBody(p)) continue;
-
-        return false;
+    // CASE 2: chain push - players lined up behind any of the pushers (the list grows as we walk back)
+    for (int k = 0; k < count; k++) {
+        int j = start.at(prevPos[line[k]].next(back));
+        if (helps(j) && !counted[j]) {
+            counted[j] = true;
+            line[count++] = j;
+        }
     }
 
-    return true;
+    int force = 0;
+    for (int k = 0; k < count; k++)
+        force += players[line[k]].getSpeed();
+
+    return force;
 }
 
-bool GameBase::chainPushSuccess(int idx, Direction dir, const Point& obstaclePos) {
-    Screen& room = screens[currRoomID];
-    Obstacle* ob = room.getObstacleAt(obstaclePos);
-    if (!ob) return false;
+bool GameBase::canMoveObstacle(int roomID, const Obstacle& ob, Direction dir)
+{
+    Screen& room = screens[roomID];
+    bool free = true;
 
-    // check combined force (existing logic)
-    int force = calcForce(players[idx], ob, dir);
-    if (force < ob->getSize()) return false;
+    // Only the cells in front of the leading edge are new - the rest of the way is the obstacle itself
+    ob.forEachLeadingCell(dir, [&](const Point& cell) {
+        Point p = cell.next(dir);
 
-    // check obstacle can actually move
-    auto nextBody = ob->getNextBody(dir);
-    if (!canMoveObstacle(nextBody, ob)) return false;
+        if (!room.getSize().contains(p) ||
+            liveCells[roomID].at(p) != -1 ||    // a player stands there
+            room.charAt(p) != ' ')
+            free = false;
+    });
 
-    // push is real and will happen
-    return true;
+    return free;
 }
 
 void GameBase::applyLifeLoss(Player& player)
@@ -1111,6 +1580,15 @@ void GameBase::applyLifeLoss(Player& player)
     bool stillAlive = player.lowerLife();
     if (results) { results->addLostLife(gameCycles); }
 
+    // Dead players come back once their respawn timer expires
+    TimerEvent respawn;
+    respawn.type = TimerType::PlayerRespawn;
+    respawn.owner = indexOf(player);
+    cancelPlayerTimers(player);
+    player.stopAcceleration();
+    // Counted from the tick the player died in: blasts go off once the wheel moved on to that tick
+    player.getRespawnTimer() = timers.scheduleAt(timers.now() + RESPAWN_TICKS, respawn);
+
     // Player has no lives left -> end game
     if (!stillAlive)
     {
@@ -1121,41 +1599,31 @@ void GameBase::applyLifeLoss(Player& player)
 }
 
 // UI Display Functions
-void GameBase::displayLegend(const Screen& room) const {
+void GameBase::displayLegend(const Screen& room, const Viewport& view) const {
     const LegendArea& legend = room.getLegend();
     if (!legend.exists) return;
 
-    int x0 = legend.topLeft.getX();
-    int y0 = legend.topLeft.getY();
-
-    // 1. Clear entire legend area
-    for (int y = 0; y < LEGEND_HEIGHT; ++y) {
-        Utils::gotoxy(x0, y0 + y);
-        std::cout << std::string(LEGEND_WIDTH, ' ');
-    }
+    // Drawn where the room placed it - while that is scrolled out of view, in the top left corner
+    Point anchor = (view.contains(legend.topLeft) && view.contains(legend.bottomRight))
+        ? view.toWindow(legend.topLeft) : Point(0, 0);
+    int x0 = anchor.getX();
+    int y0 = anchor.getY();
+    int height = legend.bottomRight.getY() - legend.topLeft.getY() + 1;     // one row per player + frame
 
-    // 2. Draw frame
+    // 1. Draw frame (clears the area inside it)
     // Top border
-    Utils::gotoxy(x0, y0);
-    std::cout << LEGEND_CORNER
-        << std::string(LEGEND_WIDTH - 2, LEGEND_H_BORDER)
-        << LEGEND_CORNER;
+    std::string border = LEGEND_CORNER + std::string(LEGEND_WIDTH - 2, LEGEND_H_BORDER) + LEGEND_CORNER;
+    view.text(Point(x0, y0), border);
 
     // Side borders
-    for (int y = 1; y < LEGEND_HEIGHT - 1; ++y) {
-        Utils::gotoxy(x0, y0 + y);
-        std::cout << LEGEND_V_BORDER
-            << std::string(LEGEND_WIDTH - 2, ' ')
-            << LEGEND_V_BORDER;
-    }
+    std::string side = LEGEND_V_BORDER + std::string(LEGEND_WIDTH - 2, ' ') + LEGEND_V_BORDER;
+    for (int y = 1; y < height - 1; ++y)
+        view.text(Point(x0, y0 + y), side);
 
     // Bottom border
-    Utils::gotoxy(x0, y0 + LEGEND_HEIGHT - 1);
-    std::cout << LEGEND_CORNER
-        << std::string(LEGEND_WIDTH - 2, LEGEND_H_BORDER)
-        << LEGEND_CORNER;
+    view.text(Point(x0, y0 + height - 1), border);
 
-    // 3. Draw content (inside frame)
+    // 2. Draw content (inside frame)
 
     int cx = x0 + 1; // content start X
     int cy = y0 + 1; // content start Y
@@ -1165,84 +1633,97 @@ void GameBase::displayLegend(const Screen& room) const {
     int colInv = cx + 18;
 
     // --- Header ---
-    Utils::gotoxy(cx + 3, cy);
-
-    std::cout << "SCORE  LIVES  INV";
-
-    // Line 2
-     // --- Player 1 ---
-    Utils::gotoxy(colScore, cy + 1);
-    std::cout << "P1: " << players[PLAYER_1].getScore();
+    view.text(Point(cx + 3, cy), "SCORE  LIVES  INV");
 
-    Utils::gotoxy(colLives, cy + 1);
-    for (int i = 0; i < players[PLAYER_1].getLife(); ++i)
-        std::cout << "<3 ";
+    // --- One line per player ---
+    for (int p = 0; p < numPlayers; ++p) {
+        const Player& player = players[p];
+        int row = cy + 1 + p;
 
-    Utils::gotoxy(colInv, cy + 1);
-    std::cout << players[PLAYER_1].getInventoryChar();
+        view.text(Point(colScore, row), "P" + std::to_string(p + 1) + ": " + std::to_string(player.getScore()));
 
-    // --- Player 2 ---
-    Utils::gotoxy(colScore, cy + 2);
-    std::cout << "P2: " << players[PLAYER_2].getScore();
+        std::string lives;
+        for (int i = 0; i < player.getLife(); ++i)
+            lives += "<3 ";
+        view.text(Point(colLives, row), lives);
 
-    Utils::gotoxy(colLives, cy + 2);
-    for (int i = 0; i < players[PLAYER_2].getLife(); ++i)
-        std::cout << "<3 ";
-
-    Utils::gotoxy(colInv, cy + 2);
-    std::cout << players[PLAYER_2].getInventoryChar();
+        view.text(Point(colInv, row), std::string(1, player.getInventoryChar()));
+    }
 }
 
-void GameBase::displayFinalScoreboard() const {
-    int score1 = players[PLAYER_1].getScore();
-    int score2 = players[PLAYER_2].getScore();
-    int totalScore = score1 + score2;
+void GameBase::displayFinalScoreboard(const Viewport& view) const {
+    int totalScore = getTotalScore();
 
     // Center the scoreboard horizontally
     const int boxWidth = FINAL_SCOREBOARD_WIDTH;
-    const int startX = (SCREEN_WIDTH - boxWidth) / 2;
+    const int startX = (view.getWidth() - boxWidth) / 2;
     const int startY = FINAL_SCOREBOARD_START_Y;
 
-    Utils::gotoxy(startX, startY);
-    std::cout << "====================";
+    view.text(Point(startX, startY), "====================");
+    view.text(Point(startX, startY + 1), "   FINAL SCORES");
+    view.text(Point(startX, startY + 2), "--------------------");
 
-    Utils::gotoxy(startX, startY + 1);
-    std::cout << "   FINAL SCORES";
+    for (int p = 0; p < numPlayers; ++p)
+        view.text(Point(startX, startY + 3 + p), "Player " + std::to_string(p + 1) + " : " + std::to_string(players[p].getScore()));
 
-    Utils::gotoxy(startX, startY + 2);
-    std::cout << "--------------------";
+    int y = startY + 3 + numPlayers;
 
-    Utils::gotoxy(startX, startY + 3);
-    std::cout << "Player 1 : " << score1;
-
-    Utils::gotoxy(startX, startY + 4);
-    std::cout << "Player 2 : " << score2;
+    view.text(Point(startX, y), "--------------------");
+    view.text(Point(startX, y + 1), "TEAM SCORE : " + std::to_string(totalScore));
+    view.text(Point(startX, y + 2), "====================");
+}
 
-    Utils::gotoxy(startX, startY + 5);
-    std::cout << "--------------------";
+// One pane per room a player is still playing in (the shown room once everybody is done).
+// The terminal is split again only when that set of rooms changes
+void GameBase::layoutPanes() {
+    std::vector<int> rooms;
+    for (int i = 0; i < numPlayers; ++i) {
+        if (!playerFinished[i] && std::find(rooms.begin(), rooms.end(), playerRoom[i]) == rooms.end())
+            rooms.push_back(playerRoom[i]);
+    }
+    if (rooms.empty())
+        rooms.push_back(currRoomID);
 
-    Utils::gotoxy(startX, startY + 6);
-    std::cout << "TEAM SCORE : " << totalScore;
+    bool same = rooms.size() == panes.size() &&
+        std::equal(rooms.begin(), rooms.end(), panes.begin(), [](int id, const RoomPane& p) { return id == p.roomID; });
+    if (same)
+        return;
 
-    Utils::gotoxy(startX, startY + 7);
-    std::cout << "====================";
+    frame.layout(static_cast<int>(rooms.size()));
+    panes.clear();
+    for (int k = 0; k < static_cast<int>(rooms.size()); ++k)
+        panes.push_back({ rooms[k], Viewport(&frame, k, frame.paneAt(k), frame.paneWidth(k), frame.paneHeight(k)) });
 }
 
-void GameBase::drawPlayers() const {
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        // if player isn't in current room (moved on to the next one) - no need to draw them
-        if (playerRoom[i] != currRoomID || players[i].getDead())
+void GameBase::drawPlayers(const RoomPane& pane) const {
+    for (int i = 0; i < numPlayers; ++i) {
+        // only the players standing in this pane's room
+        if (playerRoom[i] != pane.roomID || players[i].getDead())
             continue;
 
-        // draw players present in the current room
-        players[i].draw();
+        players[i].draw(pane.view);
+    }
+}
+
+// Keeps the players of a pane's room in view (a standard room on the whole terminal is always shown whole)
+void GameBase::followPlayers(RoomPane& pane)
+{
+    int sumX = 0, sumY = 0, count = 0;
+    for (int i = 0; i < numPlayers; ++i) {
+        if (playerRoom[i] != pane.roomID || playerFinished[i] || players[i].getDead())
+            continue;
+        sumX += players[i].getPos().getX();
+        sumY += players[i].getPos().getY();
+        count++;
     }
+    if (count > 0)
+        pane.view.follow(Point(sumX / count, sumY / count), screens[pane.roomID].getSize());
 }
 
 int GameBase::getTotalScore() const
 {
     int totalScore = 0;
-    for (int i = 0; i < NUM_PLAYERS; i++)
+    for (int i = 0; i < numPlayers; i++)
     {
         totalScore += players[i].getScore();
     }
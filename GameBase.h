@@ -12,22 +12,85 @@
 #include <algorithm>
 #include "Steps.h"
 #include "Results.h"
+#include "TimerWheel.h"
+#include "WorkerPool.h"
+#include "OccupancyGrid.h"
+#include "RoomLoader.h"
+#include "RoomSnapshot.h"
+#include "FrameCompositor.h"
+#include "FrameShare.h"
+#include "GameSave.h"
+#include "RoomCache.h"
+#include "ScreenId.h"
 
 
 class GameBase {
 private:
     std::vector<Screen> screens;
-    int currRoomID;
-
-    Player players[NUM_PLAYERS];
-    int playerRoom[NUM_PLAYERS];
-    int roomsDone[NUM_PLAYERS];
-    bool playerFinished[NUM_PLAYERS];
-    Point prevPos[NUM_PLAYERS];
+    std::vector<std::string> roomFiles;     // per room: its screen file (empty for the final room)
+    std::vector<std::uint64_t> roomHashes;  // per room: hash of its screen file's content (see ScreenId.h)
+    std::shared_ptr<const RiddleStore> riddles; // read once per game, shared with the other games (see RiddleStore.h)
+    int numRooms = 0;                       // rooms with a screen file
+    std::vector<RoomSnapshot> snapshots;    // per room: its state while it is unloaded (empty if never unloaded)
+    bool wholeWorld = false;                // every room stays loaded (see loadWholeWorld)
+    bool hosted = false;                    // by a server (see host)
+    RoomLoader roomLoader{ [this](int roomID, std::string& errorMsg, std::string& warningMsg) {
+        return loadRoom(roomID, errorMsg, warningMsg); },
+        [this](int roomID) { unloadRoom(roomID); } };
+    int currRoomID;                         // room shown on screen (every room with a player is simulated)
+
+    // A room on the terminal - every room with a player still playing has one
+    struct RoomPane {
+        int roomID;
+        Viewport view;
+    };
+    FrameCompositor frame;
+    std::vector<RoomPane> panes;            // in the order of the players standing in them
+    FrameShare spectators;                  // every presented frame, for other terminals (-spectate)
+
+    int numPlayers = DEFAULT_PLAYERS;       // players taking part (players file, or the default two)
+    Player players[MAX_PLAYERS];
+    int playerRoom[MAX_PLAYERS];
+    int roomsDone[MAX_PLAYERS];
+    bool playerFinished[MAX_PLAYERS];
+    Point prevPos[MAX_PLAYERS];             // positions at the start of the current movement round
+    int pendingRoom[MAX_PLAYERS];           // door a player passed this tick (-1 if none) - applied after all rooms ran
+
+    std::vector<OccupancyGrid> startCells;  // per room: where players stood when the tick started
+    std::vector<OccupancyGrid> liveCells;   // per room: where players stand right now
+    std::vector<OccupancyGrid> claimCells;  // per room: scratch grid for cells claimed by moving players
+
+    // What a player wants to do in one movement round
+    struct MoveIntent {
+        Point path[MAX_SUB_STEPS];  // cells entered, in order (none when staying)
+        int length = 0;
+        bool active = false;        // takes a step this round
+        bool blocked = false;       // lost a conflict with another player
+        bool contested = false;     // another player wanted one of the same cells
+
+        bool enters(const Point& p) const {
+            return std::find(path, path + length, p) != path + length;
+        }
+    };
 
     Steps* steps;
     Results* results;
 
+    TimerWheel timers;                      // every timed entity in every room (bombs, respawn, acceleration)
+    std::vector<TimerEvent> expiredTimers;  // reused buffer for the timers that fire each tick
+
+    std::vector<int> activeRooms;           // rooms with a player in them, simulated this tick
+    std::vector<Results> roomEvents;        // results recorded by each active room, merged in room order
+    // A riddle a player stepped at - asked once every room ran, so the order doesn't depend on the threads
+    struct RiddleEncounter {
+        int player;
+        Point pos;
+    };
+    std::vector<std::vector<RiddleEncounter>> roomRiddles;   // per active room, in the order they came up
+    WorkerPool roomWorkers;
+    static thread_local Results* stagedResults;   // set while a room is simulated on this thread
+    static thread_local std::vector<RiddleEncounter>* stagedRiddles;
+
 protected:
     bool isRunning;
     bool gameOver;
@@ -36,7 +99,7 @@ protected:
     // Getters 
     bool isFinalRoom(int dest) const { return dest == static_cast<int>(screens.size()) - 1; }
     Steps* getSteps() const { return steps; }
-    Results* getResults() const { return results; }
+    Results* getResults() const { return stagedResults ? stagedResults : results; }
 
     // Setters 
     void setGame();
@@ -58,40 +121,85 @@ protected:
     virtual void onPlayerDeath() = 0;
 
     // ----- Core Game Loop -----
+    virtual void tick();                    // one cycle: input, then the world moves on
     void update();
     virtual void render();
 
     // ----- Init Functions -----
     void initGame();
     bool loadGameFiles();
+    bool loadManifest(std::vector<std::string>& files);
     bool initGameFiles(const std::vector<std::string> &foundFiles);
     bool loadRiddles();
-    bool loadRiddles(int loadRoomID);
+    bool loadRiddles(int loadRoomID, std::string& errorMsg);
+    bool loadRoom(int roomID, std::string& errorMsg, std::string& warningMsg);   // may run on the loader's thread
+    bool ensureRoom(int roomID);
+    void unloadRoom(int roomID);
+    void prefetchFrom(int roomID);
+    void trimRooms();
+    bool loadWholeWorld();                  // loads every room now and never unloads one
+    bool loadPlayers();
 
     // --Used in Derived Classes--
     bool restartCurrentRoom();
     bool reloadRoom(int roomID);
-    void showError(const std::string& msg);
+    virtual void showError(const std::string& msg);
     virtual void showMessage(const std::string& msg);
 
     bool processKey(char ch);
+    bool processPlayerKey(int id, char ch); // only the keys of that player
     bool handleRiddles(Player& player);
-    virtual bool getRiddleAnswer(Riddle* riddle, bool& outSolved) = 0;
-    std::vector<std::string> getScreenSourceFiles() const;
+    virtual bool getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) = 0;
+    std::vector<ScreenId> getScreenIds() const;         // rooms with a screen file, in order
+    std::vector<std::string> getPlayerKeys() const;     // keys of each player (recording channels)
+    std::uint64_t stateHash() const;                    // hash of every player's position, room, life and score
+    std::string describePlayers() const;                // the same, readable - one "\n  ..." line per player
+    int getNumPlayers() const { return numPlayers; }
+    const Player& getPlayer(int id) const { return players[id]; }
+
+    // ----- State Saves (see GameSave.h) -----
+    // previous: the save of the tick before (nullptr - copy every room). Needs loadWholeWorld()
+    void saveState(GameSave& save, const GameSave* previous) const;
+    void loadState(const GameSave& save, const std::vector<bool>& changedRooms);   // rooms some later save copied
+
+    // ----- Hosted Games (see GameServer.h) -----
+    // The game shares its process with many others: its frames are kept for takeFrames() instead of
+    // written to the console, and its rooms are simulated on the calling thread and never prefetched
+    void host();
+    void takeFrames(std::string& into) { frame.takeOutput(into); }
+    void repaintFrame() { frame.repaint(); }
+
     bool isGameInFinalPhase() const {
-        return playerFinished[0] || playerFinished[1];
+        return std::find(playerFinished, playerFinished + numPlayers, true) != playerFinished + numPlayers;
+    }
+    bool allPlayersFinished() const {
+        return std::find(playerFinished, playerFinished + numPlayers, false) == playerFinished + numPlayers;
     }
 private:
     // ----- Display Functions -----
-    void displayLegend(const Screen& room) const;
-    void displayFinalScoreboard() const;
-    void drawPlayers() const;
+    void layoutPanes();
+    void displayLegend(const Screen& room, const Viewport& view) const;
+    void displayFinalScoreboard(const Viewport& view) const;
+    void drawPlayers(const RoomPane& pane) const;
+    void followPlayers(RoomPane& pane);
 
     int getTotalScore() const;
 
     // ----- Game Logic Functions -----
+    int indexOf(const Player& p) const { return static_cast<int>(&p - players); }
+    Screen& roomOf(const Player& p) { return screens[playerRoom[indexOf(p)]]; }
+    void updateRoom(int roomID, Results& events, std::vector<RiddleEncounter>& riddles);
+    void mergeRoomEffects();
+    void answerRiddles(int roomID, const std::vector<RiddleEncounter>& riddles);
+    void markOccupancy(int roomID);
+    MoveIntent getIntent(const Player& player) const;
+    int resolveIntents(int roomID, MoveIntent intents[], int order[]);
+    void headOn(int a, int b);
+    bool stepPlayer(int i);
     void moveRoom(Player& p, int dest);
     Point getStartPoint(Player& player, int idx, int dest) const;
+    int trailingPlayer(int idx) const;
+    static Point playerStartPos(int idx) { return Point(3, 9 + 2 * idx); }   // start of the first room
     bool playersCollide(int currPlayerIndex, const Point& nextPos);
     void applyLifeLoss(Player& player);
 
@@ -99,7 +207,7 @@ private:
     void handleDoor(Player& player);
     void handleSwitch(Player& player);
     bool handleSprings(Player& p);
-    void handleBombs();
+    void handleTimers();
     bool handleObstacles(Player& player, const Point& nextPos);
     void handleTorch(Player& player);
     void handleCollectibles(Player& player);
@@ -110,19 +218,22 @@ private:
     // ----- Helper Functions -----
     
     bool isMatchingKey(const Player& player, Screen& room, const Door* door);
-    void updateDoorBySwitches(int id);
-    void explodeBomb(Point center);
-    Spring* findAdjacentSpring(const Point& pos);
+    void updateDoorBySwitches(Screen& room, int id);
+    void explodeBomb(int roomID, Point center);
+    Spring* findAdjacentSpring(Screen& room, const Point& pos);
     bool compressSpring(Player& player, Spring& sp);
-    static void launchPlayer(Player& player, Spring& sp);
+    void launchPlayer(Player& player, Spring& sp);
+    void stopAcceleration(Player& player);
+    void bump(int idx, int other);
+    void cancelPlayerTimers(Player& player);
     int calcForce(const Player& pusher, const Obstacle* ob, Direction dir) const;
-    bool canMoveObstacle(const std::vector<Point>& nextBody, const Obstacle* currOb);
-    bool chainPushSuccess(int idx, Direction dir, const Point& obstaclePos);
+    bool canMoveObstacle(int roomID, const Obstacle& ob, Direction dir);
 
  public:
     GameBase();
     virtual ~GameBase();
 
     void run();
+    bool shareFrames() { return spectators.create(); }    // false if the shared memory cannot be made
 
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "Utils.h"
+#include "SlotMap.h"
 #include <string>
 #include <iostream>
 #include <iomanip>
@@ -12,10 +13,12 @@
 static constexpr int MAX_X = 79;
 static constexpr int MAX_Y = 24;
 
-static constexpr int LEGEND_HEIGHT = 5;
+static constexpr int LEGEND_FRAME_ROWS = 3;    // top + bottom border and header - one more row per player
 static constexpr int LEGEND_WIDTH = 23;
 
-static constexpr int NUM_PLAYERS = 2;
+static constexpr int MAX_PLAYERS = 8;
+static constexpr int DEFAULT_PLAYERS = 2;      // used when there is no players file
+static constexpr int NUM_PLAYER_KEYS = 6;      // RIGHT DOWN LEFT UP STAY DISPOSE
 static constexpr int KEYBOARD_DELAY = 150;
 static constexpr int LOAD_DELAY = 30;
 static constexpr int MAX_SUB_STEPS = 10;
@@ -23,6 +26,11 @@ static constexpr int MAX_SUB_STEPS = 10;
 // Input Keys Constants
 constexpr char HOME = 'H';
 constexpr char RESTART = 'R';
+constexpr const char* PLAYERS_FILE = "players.cfg";
+constexpr const char* RIDDLES_FILE = "riddles.txt";
+constexpr const char* WORLD_MANIFEST = "adv-world.manifest";   // optional list of room files, in room order
+constexpr const char* DEFAULT_PLAYER_KEYS[DEFAULT_PLAYERS] = { "DXAWSE", "LMJIKO" };   // RIGHT DOWN LEFT UP STAY DISPOSE
+static constexpr size_t STATE_HASH_INTERVAL = 64;   // cycles between state hashes in a binary recording
 
 enum { ESC = 27 };
 
@@ -32,7 +40,8 @@ enum ScreenID {
     NUM_SCREENS = 2
 };
 constexpr int MIN_REQUIRED_ROOMS = 3;
-constexpr int MAX_ROOMS_CAPACITY = 8;
+constexpr int MAX_NUMBERED_ROOMS = 99;      // adv-world_01 .. adv-world_99 are found without a manifest
+constexpr size_t RESIDENT_ROOMS = 16;       // rooms kept loaded - the others wait as snapshots (see RoomSnapshot.h)
 static constexpr int ROOM1_SCREEN = 1;
 constexpr int FINAL_SCOREBOARD_START_Y = 8;
 constexpr int FINAL_SCOREBOARD_WIDTH = 20;
@@ -48,6 +57,8 @@ constexpr char LEGEND = 'L';
 constexpr char LEGEND_H_BORDER = '-';
 constexpr char LEGEND_V_BORDER = '|';
 constexpr char LEGEND_CORNER = '+';
+constexpr char PANE_V_SEPARATOR = ':';      // between rooms shown side by side
+constexpr char PANE_H_SEPARATOR = '~';      // between rooms shown one above the other
 
 constexpr char BOARD_WALL = 'W';
 constexpr char WALL_VERT = '|';
@@ -72,11 +83,13 @@ enum PlayerID { PLAYER_1 = 0, PLAYER_2 = 1 };
 
 enum Direction { RIGHT, DOWN, LEFT, UP, STAY, DISPOSE };
 
+constexpr int legendHeight(int numPlayers) { return LEGEND_FRAME_ROWS + numPlayers; }
+
 enum ItemType { NONE, KEY, BOMB, TORCH };
 
 struct Item {         
     ItemType type = NONE;
-    int Index = -1;
+    EntityHandle handle;     // the item's object in the room it was collected in
 };
 
 inline char itemTypeToChar(ItemType type)
@@ -93,6 +106,8 @@ inline char itemTypeToChar(ItemType type)
 
 enum SwitchRule { ALL_ON, ALL_OFF, NO_RULE };  // combinations of switches to open the door:
 constexpr int BOMB_BLAST_RADIUS = 3;
+constexpr int BOMB_FUSE_TICKS = 5;        // ticks from arming a bomb until it explodes
+constexpr int RESPAWN_TICKS = 21;         // ticks a dead player waits before returning to its start point
 
 // Event enum used for player's score
 enum class ScoreEvent{
@@ -121,13 +136,3 @@ inline int scoreValue(ScoreEvent e)
     }
     return 0;
 }
-
-inline bool matchRiddleAnswer(const std::string& expected,
-    const std::string& actual)
-{
-    std::string e = "|" + Utils::toUpperCase(expected) + "|";
-    std::string a = "|" + Utils::toUpperCase(actual) + "|";
-
-    return e.find(a) != std::string::npos;
-}
-
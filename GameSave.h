@@ -0,0 +1,33 @@
+#pragma once
+#include "GameDefs.h"
+#include "Player.h"
+#include "Screen.h"
+#include "TimerWheel.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// File: GameSave.h
+// Description:
+//   The whole state of a game at the start of a tick, kept in memory so a network game can go back
+//   to it and simulate the ticks after it again once late inputs arrived (see NetworkGame.h).
+//   Saves share their rooms: a save copies only the rooms the coming tick can change - those with a
+//   player in them or a pending timer - and takes the others from the save before it. Restoring only
+//   puts back the rooms a later save copied, so going back costs the rooms that really moved on.
+//   Room copies keep every object in its slot, so the handles in players and timers stay valid.
+
+struct GameSave {
+    size_t tick = 0;                            // the tick about to be simulated
+    std::uint64_t hash = 0;                     // GameBase::stateHash() of this state
+
+    Player players[MAX_PLAYERS];
+    int playerRoom[MAX_PLAYERS] = {};
+    int roomsDone[MAX_PLAYERS] = {};
+    bool playerFinished[MAX_PLAYERS] = {};
+    int currRoomID = 0;
+    bool gameOver = false;
+    TimerWheel timers;
+
+    std::vector<std::shared_ptr<const Screen>> rooms;   // per room (shared with the saves around it)
+    std::vector<bool> copied;                   // per room: copied by this save, not taken from the one before
+};
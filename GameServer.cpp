@@ -0,0 +1,275 @@
+#include "GameServer.h"
+#include "NetLink.h"
+#include <chrono>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#define CLOSE_SOCKET closesocket
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define CLOSE_SOCKET ::close
+#endif
+
+namespace {
+    constexpr std::intptr_t NO_SOCKET = -1;
+
+#ifdef _WIN32
+    using PollEntry = WSAPOLLFD;
+    int waitForSockets(std::vector<PollEntry>& fds, int waitMs) {
+        return WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), waitMs);
+    }
+    bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+    void setNonBlocking(std::intptr_t s) {
+        u_long on = 1;
+        ioctlsocket(static_cast<SOCKET>(s), FIONBIO, &on);
+    }
+    std::intptr_t toHandle(SOCKET s) { return s == INVALID_SOCKET ? NO_SOCKET : static_cast<std::intptr_t>(s); }
+#else
+    using PollEntry = pollfd;
+    int waitForSockets(std::vector<PollEntry>& fds, int waitMs) {
+        return poll(fds.data(), static_cast<nfds_t>(fds.size()), waitMs);
+    }
+    bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+    void setNonBlocking(std::intptr_t s) {
+        fcntl(static_cast<int>(s), F_SETFL, fcntl(static_cast<int>(s), F_GETFL, 0) | O_NONBLOCK);
+    }
+    std::intptr_t toHandle(int s) { return s < 0 ? NO_SOCKET : static_cast<std::intptr_t>(s); }
+#endif
+
+    PollEntry entryFor(std::intptr_t s, bool wantWrite) {
+        PollEntry entry{};
+        entry.fd = static_cast<decltype(entry.fd)>(s);
+        entry.events = POLLIN | (wantWrite ? POLLOUT : 0);
+        return entry;
+    }
+}
+
+GameServer::~GameServer()
+{
+    for (Client& client : clients)
+        CLOSE_SOCKET(client.socket);
+    if (listener != NO_SOCKET)
+        CLOSE_SOCKET(listener);
+}
+
+bool GameServer::listen(int onPort, std::string& error)
+{
+    port = onPort;
+    if (!NetLink::startup(error))
+        return false;
+
+    listener = toHandle(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (listener == NO_SOCKET) {
+        error = "Cannot create a socket";
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<unsigned short>(port));
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listener, 64) != 0) {
+        error = "Cannot listen on port " + std::to_string(port);
+        CLOSE_SOCKET(listener);
+        listener = NO_SOCKET;
+        return false;
+    }
+    setNonBlocking(listener);
+    return true;
+}
+
+void GameServer::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::milliseconds(KEYBOARD_DELAY);
+    auto nextStep = Clock::now() + period;
+
+    Utils::initConsole();
+    showStatus();
+
+    std::vector<PollEntry> fds;
+    while (true) {
+        // The listener first, then one entry per client - in the order of 'clients'
+        fds.clear();
+        fds.push_back(entryFor(listener, false));
+        for (const Client& client : clients)
+            fds.push_back(entryFor(client.socket, !client.outbox.empty()));
+
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextStep - Clock::now()).count();
+        waitForSockets(fds, static_cast<int>(std::max<long long>(0, wait)));
+
+        for (size_t i = 0; i < clients.size(); i++) {
+            short events = fds[i + 1].revents;
+            if (events & (POLLIN | POLLHUP | POLLERR))
+                receive(clients[i]);
+            if ((events & POLLOUT) && !clients[i].closing)
+                flush(clients[i]);
+        }
+        if (fds[0].revents & POLLIN)
+            acceptClients();
+
+        if (Clock::now() >= nextStep) {
+            stepSessions();
+            nextStep += period;
+            if (nextStep < Clock::now())    // fell behind - keep the pace from now on
+                nextStep = Clock::now() + period;
+
+            if (Utils::hasInput() && Utils::getChar() == ESC)
+                break;
+            showStatus();
+        }
+        dropClosed();
+    }
+    Utils::restoreConsole();
+    Utils::clearScreen();
+}
+
+void GameServer::acceptClients()
+{
+    while (true) {
+        std::intptr_t s = toHandle(::accept(listener, nullptr, nullptr));
+        if (s == NO_SOCKET)
+            return;                     // no one else waiting
+        if (clients.size() >= static_cast<size_t>(MAX_SESSIONS)) {
+            static const char full[] = "The server is full - try again later\r\n";
+            ::send(s, full, sizeof(full) - 1, 0);
+            CLOSE_SOCKET(s);
+            continue;
+        }
+
+        setNonBlocking(s);
+        int noDelay = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+        Client client;
+        client.socket = s;
+        client.session.reset(new GameSession());
+        client.session->start();        // an error is shown, and ends the session with the next key
+        client.session->takeOutput(client.outbox);
+        clients.push_back(std::move(client));
+        flush(clients.back());
+    }
+}
+
+void GameServer::receive(Client& client)
+{
+    char buffer[512];
+    while (true) {
+#ifdef _WIN32
+        int got = ::recv(client.socket, buffer, sizeof(buffer), 0);
+#else
+        ssize_t got = ::recv(client.socket, buffer, sizeof(buffer), 0);
+#endif
+        if (got > 0) {
+            client.session->feed(buffer, static_cast<size_t>(got));
+            continue;
+        }
+        if (got < 0 && wouldBlock())
+            return;
+        client.closing = true;          // closed by the terminal, or broken
+        return;
+    }
+}
+
+void GameServer::flush(Client& client)
+{
+    size_t sent = 0;
+    while (sent < client.outbox.size()) {
+#ifdef _WIN32
+        int n = ::send(client.socket, client.outbox.data() + sent, static_cast<int>(client.outbox.size() - sent), 0);
+#else
+        ssize_t n = ::send(client.socket, client.outbox.data() + sent, client.outbox.size() - sent, MSG_NOSIGNAL);
+#endif
+        if (n <= 0) {
+            if (n < 0 && wouldBlock())
+                break;                  // the rest when the socket can take it
+            client.closing = true;
+            break;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    client.outbox.erase(0, sent);
+    if (client.outbox.size() > SERVER_OUTBOX_LIMIT)
+        client.closing = true;          // not reading - don't keep its frames forever
+}
+
+// Every session takes its step on the workers; the sockets are only touched on this thread
+void GameServer::stepSessions()
+{
+    workers.run(static_cast<int>(clients.size()), [this](int i) {
+        Client& client = clients[i];
+        if (client.closing)
+            return;
+        client.session->step();
+        client.session->takeOutput(client.outbox);
+    });
+
+    for (Client& client : clients) {
+        if (client.closing)
+            continue;
+        flush(client);
+        if (client.session->hasEnded())
+            client.closing = true;      // its last words are sent (or as much as the socket took)
+    }
+}
+
+void GameServer::dropClosed()
+{
+    for (size_t i = 0; i < clients.size(); ) {
+        if (clients[i].closing) {
+            CLOSE_SOCKET(clients[i].socket);
+            clients[i] = std::move(clients.back());
+            clients.pop_back();
+        }
+        else
+            i++;
+    }
+}
+
+void GameServer::showStatus()
+{
+    Utils::gotoxy(2, 2);
+    std::cout << "Serving games on port " << port << " - ESC stops the server";
+    Utils::gotoxy(2, 4);
+    std::cout << "Sessions: " << clients.size() << "    Rooms parsed: " << RoomCache::shared().size() << "        ";
+    std::cout << std::flush;
+}
+
+bool GameServer::play(int port, std::string& error)
+{
+    NetLink link;
+    if (!link.connect("127.0.0.1", port, error))
+        return false;
+
+    Utils::initConsole();
+    std::string received;
+    while (link.isConnected()) {
+        while (Utils::hasInput()) {
+            char c = Utils::getChar();
+            if (!link.send(&c, 1))
+                break;
+        }
+        link.waitForData(10);
+        received.clear();
+        bool open = link.receive(received);
+        std::cout.write(received.data(), static_cast<std::streamsize>(received.size()));
+        std::cout.flush();
+        if (!open)
+            break;
+    }
+    Utils::restoreConsole();
+    Utils::clearScreen();
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "GameSession.h"
+#include "RoomCache.h"
+#include "WorkerPool.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// File: GameServer.h
+// Description:
+//   Hosts the games of many players in one process (-serve). Each terminal that connects over TCP on
+//   this machine (-play, or any raw terminal client) gets a game session of its own (see
+//   GameSession.h).
+//   One thread waits on every socket at once and keeps the pace: every KEYBOARD_DELAY ms the
+//   sessions take one step each, side by side on a worker pool - they share nothing but the parsed
+//   rooms of the process (see RoomCache.h). What a session drew is sent without blocking; a terminal that stops
+//   reading is dropped once SERVER_OUTBOX_LIMIT bytes wait for it.
+//   A session costs its game's state and a socket - no process, thread or console of its own.
+
+constexpr int SERVER_PORT = 47048;
+constexpr int MAX_SESSIONS = 512;
+constexpr size_t SERVER_OUTBOX_LIMIT = 1 << 20;
+
+class GameServer {
+private:
+    struct Client {
+        std::intptr_t socket = -1;
+        std::unique_ptr<GameSession> session;
+        std::string outbox;             // drawn, not sent yet
+        bool closing = false;           // the terminal left - closed after this cycle
+    };
+
+    std::intptr_t listener = -1;
+    int port = SERVER_PORT;
+    std::vector<Client> clients;
+    WorkerPool workers;
+
+    void acceptClients();
+    void receive(Client& client);
+    void flush(Client& client);
+    void stepSessions();
+    void dropClosed();
+    void showStatus();
+
+public:
+    GameServer() = default;
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+    ~GameServer();
+
+    bool listen(int onPort, std::string& error);
+    void run();                         // until ESC is pressed on the server's terminal
+
+    // The terminal of one player: sends the keys, shows what the server draws - false if no server
+    static bool play(int port, std::string& error);
+};
@@ -0,0 +1,201 @@
+#include "GameSession.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    constexpr const char* CLEAR_SCREEN = "\033[2J\033[1;1H";
+    constexpr const char* HIDE_CURSOR = "\033[?25l";
+    constexpr size_t MAX_TYPED_AHEAD = 256;     // keys kept while the game doesn't take them
+    constexpr int RIDDLE_INDENT = 8;
+    constexpr int RIDDLE_ANSWER_ROW = 6;
+    const std::string ANSWER_PROMPT = "? Answer: ";
+}
+
+GameSession::GameSession() : GameBase() {
+    host();
+}
+
+bool GameSession::start() {
+    output += HIDE_CURSOR;
+    initGame();
+    if (!loadGameFiles())
+        return false;
+
+    isRunning = true;
+    gameOver = false;
+    if (mode == Mode::Playing) {        // a warning of the first room may be shown instead
+        render();
+        takeFrames(output);
+    }
+    return true;
+}
+
+void GameSession::feed(const char* data, size_t size) {
+    size = std::min(size, MAX_TYPED_AHEAD - std::min(input.size(), MAX_TYPED_AHEAD));
+    input.insert(input.end(), data, data + size);
+}
+
+void GameSession::takeOutput(std::string& into) {
+    into += output;
+    output.clear();
+}
+
+void GameSession::step() {
+    switch (mode) {
+    case Mode::Playing:
+        tick();
+        if (mode == Mode::Playing && asked)
+            showRiddle();
+        if (mode == Mode::Playing) {
+            render();
+            takeFrames(output);
+        }
+        break;
+
+    case Mode::Message:                 // any key
+        if (input.empty())
+            break;
+        input.pop_front();
+        if (endAfterMessage) {
+            end();
+            break;
+        }
+        mode = Mode::Playing;
+        repaintFrame();
+        render();
+        takeFrames(output);
+        break;
+
+    case Mode::Riddle:
+        while (mode == Mode::Riddle && !input.empty()) {
+            char c = input.front();
+            input.pop_front();
+            typeAnswer(c);
+        }
+        break;
+
+    case Mode::Ended:
+        break;
+    }
+}
+
+void GameSession::handleInput() {
+    if (input.empty()) return;          // no key pressed this frame
+
+    char key = static_cast<char>(std::toupper(input.front()));
+    input.pop_front();
+
+    // Once the game is over only H (or ESC) leaves
+    if (gameOver) {
+        if (key == HOME || key == ESC)
+            end();
+        return;
+    }
+    if (key == ESC) {
+        end();
+        return;
+    }
+    if (key == RESTART) {
+        if (!restartCurrentRoom()) end();
+        return;
+    }
+    processKey(key);
+}
+
+void GameSession::end() {
+    isRunning = false;
+    mode = Mode::Ended;
+}
+
+void GameSession::onPlayerDeath() {
+    showMessage("Player is dead. Better luck next time... -_-");
+    endAfterMessage = true;
+    gameOver = true;
+}
+
+// The player stops at the riddle and the question is shown once the tick is over. The answer comes
+// back with the player's next step into the riddle
+bool GameSession::getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) {
+    if (riddle == answered) {
+        answered = nullptr;
+        outSolved = answeredRight;
+        return true;
+    }
+    answered = nullptr;
+
+    if (!asked) {
+        asked = riddle;
+        askedPlayer = player;
+        askedDir = getPlayer(player).getDir();
+    }
+    return false;
+}
+
+void GameSession::showRiddle() {
+    mode = Mode::Riddle;
+    answer.clear();
+
+    const std::string question = asked->getQuestion();
+    std::string border(std::max<size_t>(44, question.length() + 4), '?');
+
+    output += CLEAR_SCREEN;
+    putText(RIDDLE_INDENT, 2, border);
+    putText(RIDDLE_INDENT, 4, "? " + question);
+    putText(RIDDLE_INDENT, RIDDLE_ANSWER_ROW, ANSWER_PROMPT);
+    putText(RIDDLE_INDENT, 8, border);
+    putText(RIDDLE_INDENT, 10, "Type the answer and press ENTER");
+}
+
+void GameSession::typeAnswer(char c) {
+    if (c == '\r' || c == '\n') {
+        answered = asked;
+        answeredRight = asked->accepts(answer);
+        asked = nullptr;
+
+        // The player steps into the riddle again - the next tick takes the answer
+        if (askedDir < STAY)
+            processPlayerKey(askedPlayer, getPlayer(askedPlayer).getKeys()[askedDir]);
+
+        showMessage(answeredRight ? ">>> CORRECT! You may pass. <<<" : ">>> WRONG! You shall NOT pass. <<<");
+        return;
+    }
+
+    if ((c == '\b' || c == 127) && !answer.empty())
+        answer.pop_back();
+    else if (std::isprint(static_cast<unsigned char>(c)) && answer.length() < SESSION_ANSWER_LENGTH)
+        answer += c;
+    else
+        return;
+    putText(RIDDLE_INDENT, RIDDLE_ANSWER_ROW, ANSWER_PROMPT + answer + ' ');    // the space wipes a deleted character
+}
+
+void GameSession::putText(int x, int y, const std::string& text) {
+    output += "\033[" + std::to_string(y + 1) + ';' + std::to_string(x + 1) + 'H';
+    output += text;
+}
+
+void GameSession::putCentered(int y, const std::string& text) {
+    putText(std::max(0, static_cast<int>(SCREEN_WIDTH - text.length()) / 2), y, text);
+}
+
+// As GameBase shows them, over the frame - the next key takes them away
+void GameSession::showMessage(const std::string& msg) {
+    output += CLEAR_SCREEN;
+
+    int row = 12;
+    size_t start = 0;
+    while (start <= msg.length() && row < 17) {
+        size_t stop = std::min(msg.find('\n', start), msg.length());
+        putCentered(row++, msg.substr(start, stop - start));
+        start = stop + 1;
+    }
+    putCentered(17, "Press any key to continue ");
+    mode = Mode::Message;
+}
+
+// The session can't go on after an error - the next key ends it
+void GameSession::showError(const std::string& msg) {
+    showMessage(msg);
+    putCentered(10, "ERROR:");
+    endAfterMessage = true;
+}
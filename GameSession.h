@@ -0,0 +1,55 @@
+#pragma once
+#include "GameBase.h"
+#include <deque>
+#include <string>
+
+// File: GameSession.h
+// Description:
+//   A game hosted by the game server for one connected terminal (see GameServer.h). It plays like a
+//   keyboard game without its menu, but it never waits: the server hands it what the player typed
+//   (feed) and asks for one tick at a time (step), and everything it draws is kept for the server to
+//   send (takeOutput). Messages and riddles are drawn over the frame and answered by the keys that
+//   come next - the game stands still meanwhile, as it does while a keyboard game waits for a key.
+//   ESC ends the session (there is no menu to go back to).
+
+constexpr int SESSION_ANSWER_LENGTH = 40;  // characters of a riddle answer at most
+
+class GameSession : public GameBase {
+private:
+    enum class Mode { Playing, Message, Riddle, Ended };
+    Mode mode = Mode::Playing;
+    bool endAfterMessage = false;           // the message says the game is over
+    std::deque<char> input;                 // typed, not handled yet
+    std::string output;                     // for the terminal, not taken yet
+
+    Riddle* asked = nullptr;                // riddle waiting for its answer
+    int askedPlayer = -1;
+    Direction askedDir = STAY;              // the step into the riddle, taken again once answered
+    std::string answer;                     // typed so far
+    const Riddle* answered = nullptr;       // answer for the riddle's next step
+    bool answeredRight = false;
+
+    void putText(int x, int y, const std::string& text);
+    void putCentered(int y, const std::string& text);
+    void showRiddle();
+    void typeAnswer(char c);
+    void end();
+
+protected:
+    void handleInput() override;
+    int getDelay() const override { return KEYBOARD_DELAY; }
+    void onGameEnd() override {}
+    void onPlayerDeath() override;
+    bool getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) override;
+    void showError(const std::string& msg) override;
+    void showMessage(const std::string& msg) override;
+
+public:
+    GameSession();
+
+    bool start();                           // false if the game files are wrong (the error is shown)
+    void feed(const char* data, size_t size);
+    void step();                            // one tick, or the next key for a message / riddle
+    void takeOutput(std::string& into);     // appends what was drawn since the last call
+    bool hasEnded() const { return mode == Mode::Ended; }
+};
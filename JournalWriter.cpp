@@ -0,0 +1,119 @@
+#include "JournalWriter.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool JournalWriter::open(const std::string& _filename, size_t _capacity, int checkpointMs)
+{
+    close();
+
+    file = std::fopen(_filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    filename = _filename;
+    capacity = _capacity;
+    checkpointEvery = std::chrono::milliseconds(checkpointMs);
+    pending.clear();
+    pending.reserve(capacity);
+    writing.reserve(capacity);
+    overflowed = stopping = false;
+    error.clear();
+
+    writer = std::thread(&JournalWriter::writerLoop, this);
+    return true;
+}
+
+void JournalWriter::append(const std::string& text)
+{
+    bool wakeWriter;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!file || overflowed)
+            return;
+        if (pending.size() + text.size() > capacity) {
+            overflowed = true;      // nothing after this point, so the file stays a prefix
+            return;
+        }
+        pending += text;
+        wakeWriter = pending.size() > capacity / 2;
+    }
+    if (wakeWriter)
+        wake.notify_one();
+}
+
+void JournalWriter::writerLoop()
+{
+    auto nextCheckpoint = std::chrono::steady_clock::now() + checkpointEvery;
+    bool dirty = false;             // written since the last checkpoint
+
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait_until(guard, nextCheckpoint, [&] { return stopping || pending.size() > capacity / 2; });
+            stop = stopping;
+            writing.swap(pending);  // the game appends to the other buffer while this one is written
+        }
+
+        if (!writing.empty()) {
+            if (!writeOut())
+                return;
+            writing.clear();
+            dirty = true;
+        }
+
+        if (stop || std::chrono::steady_clock::now() >= nextCheckpoint) {
+            if (dirty && !checkpoint())
+                return;
+            dirty = false;
+            nextCheckpoint = std::chrono::steady_clock::now() + checkpointEvery;
+        }
+        if (stop)
+            return;
+    }
+}
+
+bool JournalWriter::writeOut()
+{
+    if (std::fwrite(writing.data(), 1, writing.size(), file) != writing.size() || std::fflush(file) != 0) {
+        error = "Failed to write " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool JournalWriter::checkpoint()
+{
+#ifdef _WIN32
+    bool synced = _commit(_fileno(file)) == 0;
+#else
+    bool synced = fsync(fileno(file)) == 0;
+#endif
+    if (!synced)
+        error = "Failed to flush " + filename + " to disk";
+    return synced;
+}
+
+bool JournalWriter::close()
+{
+    if (!file)
+        return error.empty();
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+
+    if (overflowed && error.empty())
+        error = filename + ": the game outran the disk, the end of the recording was dropped";
+    if (std::fclose(file) != 0 && error.empty())
+        error = "Failed to write " + filename;
+    file = nullptr;
+    return error.empty();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// File: JournalWriter.h
+// Description:
+//   Appends text to a file from a background thread while the game goes on (save mode journals
+//   its steps and results with it, so a crash or a quit still leaves a replayable recording).
+//   append() only copies into a bounded buffer - the game thread never waits for the disk.
+//   The writer thread writes the buffer out and forces it to disk (fsync) every checkpoint,
+//   so after a crash the file holds at least everything up to the last checkpoint.
+//   If the buffer fills up faster than the disk takes it, later text is dropped (the file stays
+//   a clean prefix of the recording) and close() reports it.
+
+class JournalWriter {
+private:
+    std::FILE* file = nullptr;
+    std::string filename;
+    std::thread writer;
+    std::mutex lock;
+    std::condition_variable wake;
+
+    std::string pending;            // appended, not handed to the writer yet (guarded by lock)
+    std::string writing;            // the writer's buffer - only touched by the writer thread
+    size_t capacity = 0;
+    std::chrono::milliseconds checkpointEvery{ 0 };
+    bool overflowed = false;
+    bool stopping = false;
+    std::string error;              // set by the writer thread, read after it was joined
+
+    void writerLoop();
+    bool writeOut();                // writes 'writing' - false on a disk error
+    bool checkpoint();              // fsync
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024 * 1024;
+    static constexpr int DEFAULT_CHECKPOINT_MS = 1000;
+
+    JournalWriter() = default;
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+    ~JournalWriter() { close(); }
+
+    // Creates (truncates) the file and starts the writer thread
+    bool open(const std::string& _filename, size_t _capacity = DEFAULT_CAPACITY,
+        int checkpointMs = DEFAULT_CHECKPOINT_MS);
+
+    void append(const std::string& text);
+
+    // Writes everything left, forces it to disk and stops the writer.
+    // False if text was dropped or the disk failed (see getError())
+    bool close();
+    bool isOpen() const { return file != nullptr; }
+    const std::string& getError() const { return error; }
+};
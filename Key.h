@@ -25,6 +25,7 @@ public:
 
 	// Get Functions
 	bool isActive() const { return active; }
+	bool isShown() const { return active; }       // drawn on the board
 	Point getPos() const { return pos; }
 	int getDoorID() const { return DoorID; }
 	char getFigure() const { return figure; }
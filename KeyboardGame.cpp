@@ -1,8 +1,9 @@
 #include "KeyboardGame.h"
 
-KeyboardGame::KeyboardGame(bool _saveMode) :GameBase() {
+KeyboardGame::KeyboardGame(bool _saveMode, bool _binaryMode) :GameBase() {
        Utils::initConsole();
        this->saveMode = _saveMode;
+       this->binaryMode = _binaryMode;
 
        fixedScreens[MENU_SCREEN].setMap(MENU_MAP);
        fixedScreens[INSTRUCTIONS_SCREEN].setMap(INSTRUCTIONS_MAP);
@@ -21,6 +22,10 @@ KeyboardGame::~KeyboardGame() = default;
 
 
 void KeyboardGame::handleInput() {
+        // Before this cycle's key, where playback checks it too
+        if (saveMode && binaryMode && gameCycles % STATE_HASH_INTERVAL == 0)
+            stateHashes.emplace_back(gameCycles, stateHash());
+
         if (!Utils::hasInput()) return;  // no key pressed this frame
 
         char ch = Utils::getChar();
@@ -47,7 +52,7 @@ void KeyboardGame::handleInput() {
         }
     }
 
-bool KeyboardGame::getRiddleAnswer(Riddle* riddle, bool& outSolved) {
+bool KeyboardGame::getRiddleAnswer(Riddle* riddle, int, bool& outSolved) {
      
     outSolved = riddle->solve();    // Show UI and get user input
 
@@ -59,16 +64,33 @@ bool KeyboardGame::getRiddleAnswer(Riddle* riddle, bool& outSolved) {
 
 void KeyboardGame::onGameEnd()
 {
-    // Save game data only in save mode
-    if (!saveMode)
+    // Save game data only in save mode, once per game - it's called again on keys after the end
+    if (!saveMode || gameSaved)
         return;
+    gameSaved = true;
+
+    // Retrieve the screens (names and content hashes) from GameBase
+    std::vector<ScreenId> screens = getScreenIds();
+
+    if (binaryMode) {
+        RecordingWriter writer(screens, getPlayerKeys());
+        writer.addSteps(*getSteps());
+        writer.addResults(*getResults());
+        for (const auto& h : stateHashes)
+            writer.addStateHash(h.first, h.second);
 
-    // Retrieve screen source file names from GameBase
-    std::vector<std::string> screenFiles = getScreenSourceFiles();
+        if (!writer.save(Recording::DEFAULT_FILE))
+            showError("Error saving game files");
+        return;
+    }
+
+    // Journals complete - the files were written while playing
+    if (stopJournals())
+        return;
 
     // Save steps and results files
-    bool stepsOk = getSteps()->saveSteps("adv-world.steps", screenFiles);
-    bool resultsOk = getResults()->saveResults("adv-world.results", screenFiles);
+    bool stepsOk = getSteps()->saveSteps("adv-world.steps", screens);
+    bool resultsOk = getResults()->saveResults("adv-world.results", screens);
 
     // Notify the user if saving failed
     if (!stepsOk || !resultsOk) {
@@ -82,6 +104,34 @@ void KeyboardGame::onGameEnd()
         isRunning = false;
     }
 
+// Each game is recorded on its own, from the first cycle
+void KeyboardGame::startJournals()
+{
+    setSteps(new Steps());
+    setResults(new Results());
+
+    if (!stepsJournal.open("adv-world.steps") || !resultsJournal.open("adv-world.results")) {
+        stepsJournal.close();        // saved in onGameEnd() only, as without journals
+        return;
+    }
+
+    std::vector<ScreenId> screens = getScreenIds();
+    getSteps()->startJournal(&stepsJournal, screens);
+    getResults()->startJournal(&resultsJournal, screens);
+}
+
+bool KeyboardGame::stopJournals()
+{
+    if (!stepsJournal.isOpen())
+        return false;
+
+    getSteps()->stopJournal();
+    getResults()->stopJournal();
+    bool stepsOk = stepsJournal.close();
+    bool resultsOk = resultsJournal.close();
+    return stepsOk && resultsOk;
+}
+
 void KeyboardGame::pauseGame()
 {
     Utils::clearScreen();
@@ -127,7 +177,11 @@ void KeyboardGame::showMenu() {
 
             if (!loadGameFiles()) break; // file-related error: return to main menu
 
+            gameSaved = false;
+            if (saveMode && !binaryMode) startJournals();
+
             run();                       // start game
+            stopJournals();              // quit without finishing - the journals hold what was played
             break;
 
         case INSTRUCTIONS:               // Show instructions
@@ -3,11 +3,23 @@
 #include "Utils.h"
 #include "Steps.h"
 #include "Results.h"
+#include "Recording.h"
+#include "JournalWriter.h"
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 class KeyboardGame : public GameBase {
 private:
     bool saveMode;
+    bool binaryMode;                   // save a binary recording (with state hashes) instead of the text files
+    std::vector<std::pair<size_t, std::uint64_t>> stateHashes;   // pair: <iteration, state hash>
+    JournalWriter stepsJournal;        // text save mode: steps & results reach the disk while playing
+    JournalWriter resultsJournal;
+    bool gameSaved = false;            // onGameEnd() already saved this game
+
+    void startJournals();
+    bool stopJournals();               // false if they were not running or lost data
     Screen fixedScreens[NUM_SCREENS];  // Constant screens like menu\instructions
 
 protected:
@@ -16,10 +28,10 @@ protected:
     void onGameEnd() override;
     void onPlayerDeath() override;
     int getDelay() const override { return KEYBOARD_DELAY; }
-    bool getRiddleAnswer(Riddle* riddle, bool& outSolved) override;
+    bool getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) override;
 
 public:
-    explicit KeyboardGame(bool save = false);
+    explicit KeyboardGame(bool save = false, bool binary = false);
     ~KeyboardGame();  
 
     void showMenu();
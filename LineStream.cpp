@@ -0,0 +1,65 @@
+#include "LineStream.h"
+#include <cstring>
+
+LineStream::~LineStream()
+{
+    if (file)
+        std::fclose(file);
+}
+
+bool LineStream::open(const std::string& _filename, size_t bufferSize)
+{
+    file = std::fopen(_filename.c_str(), "rb");     // "\r\n" is handled by the tokenizer
+    if (!file)
+        return false;
+
+    filename = _filename;
+    capacity = bufferSize;
+    buffer.reset(new char[capacity]);
+    pos = end = buffer.get();
+    return true;
+}
+
+bool LineStream::refill()
+{
+    if (eof)
+        return false;
+
+    // Move the partial line to the front of the buffer and read after it
+    size_t kept = end - pos;
+    std::memmove(buffer.get(), pos, kept);
+    pos = buffer.get();
+    end = pos + kept;
+
+    size_t read = std::fread(end, 1, capacity - kept, file);
+    end += read;
+    if (read < capacity - kept)
+        eof = true;
+    return read > 0;
+}
+
+bool LineStream::nextLine(LineCursor& line)
+{
+    if (!file)
+        return false;
+
+    for (;;) {
+        char* newline = static_cast<char*>(std::memchr(pos, '\n', end - pos));
+        if (newline || (eof && pos < end)) {
+            char* stop = newline ? newline : end;
+            if (stop > pos && stop[-1] == '\r')       // "\r\n" line break
+                --stop;
+
+            line = LineCursor(TextView(pos, stop - pos), ++lineNumber);
+            lineComplete = newline != nullptr;
+            pos = newline ? newline + 1 : end;
+            return true;
+        }
+        if (end - pos == static_cast<std::ptrdiff_t>(capacity)) {
+            error = filename + " line " + std::to_string(lineNumber + 1) + " is too long";
+            return false;
+        }
+        if (!refill() && pos == end)
+            return false;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "TextScanner.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+// File: LineStream.h
+// Description:
+//   Reads a file line by line through a fixed-size read-ahead buffer, so memory stays the same
+//   however long the file is (used to play back recordings of any length).
+//   Lines are handed out as LineCursors into the buffer - a line is only valid until the next call.
+
+class LineStream {
+private:
+    std::FILE* file = nullptr;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity = 0;
+    char* pos = nullptr;            // next unread byte
+    char* end = nullptr;            // end of the bytes read so far
+    bool eof = false;
+    int lineNumber = 0;
+    bool lineComplete = true;       // the last line ended with a line break
+    std::string filename;
+    std::string error;
+
+    bool refill();                  // keeps the unread bytes, reads more after them
+
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    LineStream() = default;
+    LineStream(const LineStream&) = delete;
+    LineStream& operator=(const LineStream&) = delete;
+    ~LineStream();
+
+    bool open(const std::string& _filename, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    // false at the end of the file, or if a line does not fit in the buffer (see getError())
+    bool nextLine(LineCursor& line);
+
+    // False when the last line ran into the end of the file without a line break - in a journal
+    // (see JournalWriter.h) that is a write the game did not get to finish
+    bool isLineComplete() const { return lineComplete; }
+
+    const std::string& getFilename() const { return filename; }
+    const std::string& getError() const { return error; }
+};
@@ -1,27 +1,95 @@
 #include "FileGame.h"
 #include "KeyboardGame.h"
+#include "GameServer.h"
+#include "NetworkGame.h"
 #include "GameBase.h"
+#include <cstring>
 
 int main(int argc, char* argv[]) {
 	bool saveMode = false;
 	bool loadMode = false;
 	bool silentMode = false;
+	bool binaryMode = false;
+	bool packMode = false;
+	bool unpackMode = false;
+	bool spectateMode = false;
+	bool hostMode = false;
+	bool joinMode = false;
+	bool serveMode = false;
+	bool playMode = false;
 
 	for (int i = 1; i < argc; i++) {
 		if (strcmp(argv[i], "-save") == 0) saveMode = true;
 		if (strcmp(argv[i], "-load") == 0) loadMode = true;
 		if (strcmp(argv[i], "-silent") == 0) silentMode = true;
+		if (strcmp(argv[i], "-rec") == 0) binaryMode = true;
+		if (strcmp(argv[i], "-pack") == 0) packMode = true;
+		if (strcmp(argv[i], "-unpack") == 0) unpackMode = true;
+		if (strcmp(argv[i], "-spectate") == 0) spectateMode = true;
+		if (strcmp(argv[i], "-host") == 0) hostMode = true;
+		if (strcmp(argv[i], "-join") == 0) joinMode = true;
+		if (strcmp(argv[i], "-serve") == 0) serveMode = true;
+		if (strcmp(argv[i], "-play") == 0) playMode = true;
 	}
 
-	if (loadMode) {
-		FileGame game(silentMode);
+	// Conversion between the text files and a binary recording - no game is played
+	if (packMode || unpackMode) {
+		std::string errorMsg;
+		bool ok = packMode
+			? Recording::pack("adv-world.steps", "adv-world.results", Recording::DEFAULT_FILE,
+				std::vector<std::string>(DEFAULT_PLAYER_KEYS, DEFAULT_PLAYER_KEYS + DEFAULT_PLAYERS), errorMsg)
+			: Recording::unpack(Recording::DEFAULT_FILE, "adv-world.steps", "adv-world.results", errorMsg);
+		if (!ok) {
+			std::cout << errorMsg << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	// Many games in this process, one per connected terminal - or the terminal of one of them
+	if (serveMode || playMode) {
+		std::string errorMsg;
+		GameServer server;
+		bool ok = serveMode ? server.listen(SERVER_PORT, errorMsg) : GameServer::play(SERVER_PORT, errorMsg);
+		if (!ok) {
+			std::cout << errorMsg << std::endl;
+			return 1;
+		}
+		if (serveMode)
+			server.run();
+		return 0;
+	}
+
+	// Frames are published for the spectator program
+	auto shareFrames = [spectateMode](GameBase& game) {
+		if (spectateMode && !game.shareFrames()) {
+			std::cout << "Cannot share the frames with spectators" << std::endl;
+			return false;
+		}
+		return true;
+	};
+
+	// Two clients on this machine, one player each
+	if (hostMode || joinMode) {
+		NetworkGame game(hostMode);
+		if (!shareFrames(game))
+			return 1;
+		if (game.connect())
+			game.play();
+	}
+	else if (loadMode) {
+		FileGame game(silentMode, binaryMode);
+		if (!shareFrames(game))
+			return 1;
 		if (!game.loadFileGameResources()) {
 			return 0;  // file upload failed
 		}
 		game.run();
 	}
 	else {
-		KeyboardGame game(saveMode);
+		KeyboardGame game(saveMode, binaryMode);
+		if (!shareFrames(game))
+			return 1;
 		game.showMenu();
 	}
 
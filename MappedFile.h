@@ -0,0 +1,35 @@
+#pragma once
+#include "TextScanner.h"
+#include <string>
+#include <cstddef>
+
+// File: MappedFile.h
+// Description:
+//   Read-only view of a whole file mapped into memory. Parsing straight from the mapping
+//   (see TextScanner.h) avoids copying the file through stream buffers line by line.
+//   The mapping is released by the destructor, so every slice taken from it must be
+//   used (or copied) before the MappedFile goes away.
+
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    void close();
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& filename);     // false if the file cannot be opened / mapped
+
+    const char* getData() const { return data; }
+    size_t getSize() const { return size; }
+    TextScanner lines() const { return TextScanner(data, size); }
+};
@@ -0,0 +1,185 @@
+#include "NetLink.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#define CLOSE_SOCKET closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define CLOSE_SOCKET ::close
+#endif
+
+namespace {
+    constexpr std::intptr_t NO_SOCKET = -1;
+
+#ifdef _WIN32
+    std::intptr_t toHandle(SOCKET s) { return s == INVALID_SOCKET ? NO_SOCKET : static_cast<std::intptr_t>(s); }
+#else
+    std::intptr_t toHandle(int s) { return s < 0 ? NO_SOCKET : static_cast<std::intptr_t>(s); }
+#endif
+
+    bool fillAddress(const std::string& address, int port, sockaddr_in& addr) {
+        addr = sockaddr_in{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<unsigned short>(port));
+        return inet_pton(AF_INET, address.c_str(), &addr.sin_addr) == 1;
+    }
+
+    // Waits until the socket can be read - false on timeout
+    bool readable(std::intptr_t s, int waitMs) {
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(s, &fds);
+        timeval tv;
+        tv.tv_sec = waitMs / 1000;
+        tv.tv_usec = (waitMs % 1000) * 1000;
+        return select(static_cast<int>(s) + 1, &fds, nullptr, nullptr, &tv) > 0;
+    }
+}
+
+bool NetLink::startup(std::string& error)
+{
+#ifdef _WIN32
+    static bool started = false;
+    if (!started) {
+        WSADATA data;
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+            error = "Cannot start networking";
+            return false;
+        }
+        started = true;
+    }
+#else
+    (void)error;
+#endif
+    return true;
+}
+
+bool NetLink::listen(int port, std::string& error)
+{
+    close();
+    if (!startup(error))
+        return false;
+
+    listener = toHandle(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (listener == NO_SOCKET) {
+        error = "Cannot create a socket";
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in addr;
+    fillAddress("127.0.0.1", port, addr);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listener, 1) != 0) {
+        error = "Cannot listen on port " + std::to_string(port);
+        close();
+        return false;
+    }
+    return true;
+}
+
+int NetLink::accept(int waitMs, std::string& error)
+{
+    if (listener == NO_SOCKET) {
+        error = "Not listening";
+        return -1;
+    }
+    if (!readable(listener, waitMs))
+        return 0;
+
+    peer = toHandle(::accept(listener, nullptr, nullptr));
+    if (peer == NO_SOCKET) {
+        error = "Cannot accept the other player";
+        return -1;
+    }
+    CLOSE_SOCKET(listener);         // one other player - nobody else may join
+    listener = NO_SOCKET;
+
+    int noDelay = 1;
+    setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    return 1;
+}
+
+bool NetLink::connect(const std::string& address, int port, std::string& error)
+{
+    close();
+    if (!startup(error))
+        return false;
+
+    sockaddr_in addr;
+    if (!fillAddress(address, port, addr)) {
+        error = "Bad address " + address;
+        return false;
+    }
+    peer = toHandle(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (peer == NO_SOCKET) {
+        error = "Cannot create a socket";
+        return false;
+    }
+    if (::connect(peer, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        error = "Nobody is hosting a game on port " + std::to_string(port);
+        close();
+        return false;
+    }
+
+    int noDelay = 1;
+    setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    return true;
+}
+
+bool NetLink::send(const char* data, size_t size)
+{
+    while (size > 0 && peer != NO_SOCKET) {
+#ifdef _WIN32
+        int sent = ::send(peer, data, static_cast<int>(size), 0);
+#else
+        ssize_t sent = ::send(peer, data, size, MSG_NOSIGNAL);
+#endif
+        if (sent <= 0) {
+            close();
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return peer != NO_SOCKET;
+}
+
+bool NetLink::receive(std::string& into)
+{
+    char buffer[512];
+    while (peer != NO_SOCKET && readable(peer, 0)) {
+#ifdef _WIN32
+        int got = ::recv(peer, buffer, sizeof(buffer), 0);
+#else
+        ssize_t got = ::recv(peer, buffer, sizeof(buffer), 0);
+#endif
+        if (got <= 0) {             // closed by the other side, or broken
+            close();
+            return false;
+        }
+        into.append(buffer, static_cast<size_t>(got));
+    }
+    return peer != NO_SOCKET;
+}
+
+bool NetLink::waitForData(int waitMs)
+{
+    return peer != NO_SOCKET && readable(peer, waitMs);
+}
+
+void NetLink::close()
+{
+    if (peer != NO_SOCKET)
+        CLOSE_SOCKET(peer);
+    if (listener != NO_SOCKET)
+        CLOSE_SOCKET(listener);
+    peer = listener = NO_SOCKET;
+}
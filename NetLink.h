@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// File: NetLink.h
+// Description:
+//   The TCP connection between the two clients of a network game (see NetworkGame.h).
+//   One client listens and accepts, the other connects - after that both just send and receive
+//   bytes, in order. receive() never waits, so the game loop keeps its pace while the other
+//   client is quiet. Small writes are sent at once (no Nagle delay): every tick sends a few bytes.
+
+class NetLink {
+private:
+    std::intptr_t listener = -1;        // sockets (SOCKET on Windows), -1 if none
+    std::intptr_t peer = -1;
+
+public:
+    static bool startup(std::string& error);    // Winsock needs it once per process
+
+    NetLink() = default;
+    NetLink(const NetLink&) = delete;
+    NetLink& operator=(const NetLink&) = delete;
+    ~NetLink() { close(); }
+
+    bool listen(int port, std::string& error);
+    // Takes the connecting client - 1 connected, 0 nobody within waitMs, -1 error
+    int accept(int waitMs, std::string& error);
+    // false if nobody listens there (yet)
+    bool connect(const std::string& address, int port, std::string& error);
+
+    bool send(const char* data, size_t size);   // false once the connection is gone
+    bool receive(std::string& into);            // appends what arrived - false once the connection is gone
+    bool waitForData(int waitMs);               // something arrived within waitMs (or the connection closed)
+
+    void close();
+    bool isConnected() const { return peer != -1; }
+};
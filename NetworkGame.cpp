@@ -0,0 +1,336 @@
+#include "NetworkGame.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace {
+    constexpr std::uint32_t NET_MAGIC = 0x504E5741;     // "AWNP"
+    constexpr std::uint32_t NET_VERSION = 1;
+
+    // Messages: a type byte, then fixed-size little-endian fields
+    enum : char { MSG_HELLO = 'H', MSG_INPUT = 'I', MSG_HASH = 'S' };
+    constexpr size_t HELLO_SIZE = 1 + 4 + 4 + 8 + 8;    // magic, version, world hash, keys hash
+    constexpr size_t INPUT_SIZE = 1 + 4 + 1 + 1;        // tick, key, riddle answer
+    constexpr size_t HASH_SIZE = 1 + 4 + 8;             // tick, state hash
+
+    void put(std::string& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    std::uint64_t get(const std::string& in, size_t at, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++)
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[at + i])) << (8 * i);
+        return value;
+    }
+
+    void showStatus(const std::string& text) {
+        Utils::clearScreen();
+        Utils::gotoxy(static_cast<int>(SCREEN_WIDTH - text.length()) / 2, 12);
+        std::cout << text << std::flush;
+    }
+}
+
+NetworkGame::NetworkGame(bool host) : GameBase(), hosting(host), me(host ? PLAYER_1 : PLAYER_2) {
+    Utils::initConsole();
+}
+
+NetworkGame::~NetworkGame() {
+    Utils::restoreConsole();
+}
+
+bool NetworkGame::connect() {
+    std::string error;
+
+    if (hosting) {
+        if (!link.listen(NET_PORT, error)) {
+            showError(error);
+            return false;
+        }
+        showStatus("Waiting for the other player on port " + std::to_string(NET_PORT) + "... (ESC to cancel)");
+        while (true) {
+            int result = link.accept(100, error);
+            if (result < 0) {
+                showError(error);
+                return false;
+            }
+            if (result > 0)
+                return true;
+            if (Utils::hasInput() && Utils::getChar() == ESC)
+                return false;
+        }
+    }
+
+    // The host may not be there yet - keep trying
+    showStatus("Looking for a game on port " + std::to_string(NET_PORT) + "... (ESC to cancel)");
+    while (!link.connect("127.0.0.1", NET_PORT, error)) {
+        if (Utils::hasInput() && Utils::getChar() == ESC)
+            return false;
+        Utils::delay(200);
+    }
+    return true;
+}
+
+// Both clients must play the same world with the same players
+bool NetworkGame::handshake() {
+    std::uint64_t world = worldHash(getScreenIds()), keysHash = Utils::HASH_SEED;
+    for (const std::string& keys : getPlayerKeys())
+        keysHash = Utils::hashBytes(keys.data(), keys.size(), keysHash);
+
+    std::string hello(1, MSG_HELLO);
+    put(hello, NET_MAGIC, 4);
+    put(hello, NET_VERSION, 4);
+    put(hello, world, 8);
+    put(hello, keysHash, 8);
+    if (!link.send(hello.data(), hello.size())) {
+        showError("The other player left the game");
+        return false;
+    }
+
+    showStatus("Waiting for the other player's world...");
+    for (int waited = 0; inbox.size() < HELLO_SIZE; waited += 100) {
+        if (waited >= NET_HELLO_WAIT_MS || (link.waitForData(100) && !link.receive(inbox) && inbox.size() < HELLO_SIZE)) {
+            showError("The other player did not answer");
+            return false;
+        }
+    }
+    if (inbox[0] != MSG_HELLO || get(inbox, 1, 4) != NET_MAGIC || get(inbox, 5, 4) != NET_VERSION) {
+        showError("The other side is not this game");
+        return false;
+    }
+    if (get(inbox, 9, 8) != world || get(inbox, 17, 8) != keysHash) {
+        showError("The other player has different screen files\nor players (players.cfg)");
+        return false;
+    }
+    inbox.erase(0, HELLO_SIZE);
+    return true;
+}
+
+void NetworkGame::play() {
+    initGame();
+    if (!loadGameFiles()) return;
+
+    if (getNumPlayers() != 2) {
+        showError("A network game is for two players\n(see players.cfg)");
+        return;
+    }
+    if (!loadWholeWorld()) return;
+    if (!handshake()) return;
+
+    // Nobody pressed anything in the first ticks - their inputs are known from the start
+    firstTick = gameCycles + 1;
+    for (InputChannel& channel : inputs) {
+        channel.reset(firstTick);
+        for (int t = 0; t < INPUT_DELAY; t++)
+            channel.push(firstTick + t, TickInput());
+    }
+    finalTick = gameCycles;
+
+    run();
+    link.close();
+}
+
+// A cycle: inputs that arrived may send the game back a few ticks, then it moves on by one tick
+// unless it is too far ahead of the other player
+void NetworkGame::tick() {
+    if (!receiveAll()) {
+        if (!leaving)
+            endWithMessage("The other player left the game");
+        return;
+    }
+    if (rollbackFrom != 0)
+        rollback();
+    if (!finalize() || !isRunning)
+        return;
+
+    size_t next = gameCycles + 1;
+    if (next >= inputs[1 - me].knownUntil() + ROLLBACK_TICKS)
+        return;                         // wait for the other player
+
+    handleInput();
+    if (leaving) {
+        isRunning = false;
+        return;
+    }
+    if (!sendInput(next + INPUT_DELAY)) {
+        endWithMessage("The other player left the game");
+        return;
+    }
+    simulate(next, true);
+}
+
+void NetworkGame::handleInput() {
+    if (!Utils::hasInput()) return;     // no key pressed this frame
+
+    char key = static_cast<char>(std::toupper(Utils::getChar()));
+
+    // A network game can't be paused - ESC leaves it (and H once it is over)
+    if (key == ESC || (gameOver && key == HOME)) {
+        leaving = true;
+        return;
+    }
+    const Player& player = getPlayer(me);
+    if (player.isMoveKey(key) || player.isDisposeKey(key))
+        pendingKey = key;
+}
+
+bool NetworkGame::sendInput(size_t tick) {
+    TickInput input;
+    input.key = pendingKey;
+    pendingKey = 0;
+    if (pendingAnswer != TickInput::NO_ANSWER) {
+        input.key = answerKey;
+        input.riddle = pendingAnswer;
+        pendingAnswer = TickInput::NO_ANSWER;
+        askAgainAfter = tick;
+    }
+    inputs[me].push(tick, input);
+
+    std::string msg(1, MSG_INPUT);
+    put(msg, tick, 4);
+    msg += input.key;
+    msg += static_cast<char>(input.riddle);
+    return link.send(msg.data(), msg.size());
+}
+
+bool NetworkGame::receiveAll() {
+    bool open = link.receive(inbox);
+    int other = 1 - me;
+
+    size_t at = 0;
+    while (at < inbox.size()) {
+        char type = inbox[at];
+        size_t size = (type == MSG_INPUT) ? INPUT_SIZE : (type == MSG_HASH) ? HASH_SIZE : 0;
+        if (size == 0)
+            return false;               // not a message of this game
+        if (inbox.size() - at < size)
+            break;                      // the rest is on its way
+
+        size_t tick = static_cast<size_t>(get(inbox, at + 1, 4));
+        if (type == MSG_INPUT) {
+            TickInput input;
+            input.key = inbox[at + 5];
+            input.riddle = static_cast<signed char>(inbox[at + 6]);
+            if (!inputs[other].push(tick, input))
+                return false;
+            // Simulated already, predicted as empty
+            if (!input.isEmpty() && tick <= gameCycles && (rollbackFrom == 0 || tick < rollbackFrom))
+                rollbackFrom = tick;
+        }
+        else {
+            theirHashes[tick] = get(inbox, at + 5, 8);
+        }
+        at += size;
+    }
+    inbox.erase(0, at);
+    return open;
+}
+
+// Goes back to the first tick that was simulated with a wrong prediction and simulates the ticks
+// since again, now with the real inputs
+void NetworkGame::rollback() {
+    size_t from = rollbackFrom;
+    size_t last = gameCycles;
+    rollbackFrom = 0;
+
+    const GameSave& start = saveOf(from);
+    std::vector<bool> changed(start.rooms.size(), false);
+    for (size_t t = from; t <= last; t++) {
+        const std::vector<bool>& copied = saveOf(t).copied;
+        for (size_t roomID = 0; roomID < changed.size(); roomID++)
+            changed[roomID] = changed[roomID] || copied[roomID];
+    }
+    loadState(start, changed);
+
+    for (size_t t = from; t <= last; t++)
+        simulate(t, t != from);         // the state of 'from' is its save already
+}
+
+void NetworkGame::simulate(size_t tick, bool save) {
+    if (save)
+        saveState(saveOf(tick), tick > firstTick ? &saveOf(tick - 1) : nullptr);
+
+    gameCycles = tick;
+    for (int i = 0; i < 2; i++) {       // players in order, whichever client's input came first
+        TickInput input = inputs[i].at(tick);
+        if (input.key != 0)
+            processPlayerKey(i, input.key);
+    }
+    if (!gameOver)
+        update();
+}
+
+// Ticks every input of is known won't be simulated again: their hashes are compared with the
+// other client's, and the game only ends on a final state
+bool NetworkGame::finalize() {
+    size_t known = std::min(inputs[0].knownUntil(), inputs[1].knownUntil());
+    size_t upTo = std::min(known, gameCycles);
+
+    for (size_t t = finalTick + 1; t <= upTo; t++) {
+        if (t % STATE_HASH_INTERVAL != 0)
+            continue;
+        myHashes[t] = saveOf(t).hash;
+
+        std::string msg(1, MSG_HASH);
+        put(msg, t, 4);
+        put(msg, saveOf(t).hash, 8);
+        link.send(msg.data(), msg.size());
+    }
+    finalTick = std::max(finalTick, upTo);
+    for (const auto& hash : theirHashes) {
+        auto mine = myHashes.find(hash.first);
+        if (mine != myHashes.end() && mine->second != hash.second) {
+            endWithMessage("The game went out of sync at tick " + std::to_string(hash.first));
+            return false;
+        }
+    }
+    for (auto it = theirHashes.begin(); it != theirHashes.end(); ) {
+        if (myHashes.erase(it->first))
+            it = theirHashes.erase(it);
+        else
+            ++it;
+    }
+
+    // Final ticks are never simulated again - their inputs are not needed any more
+    for (InputChannel& channel : inputs)
+        channel.dropBefore(finalTick + 1);
+
+    if (gameOver && known > gameCycles) {
+        for (int i = 0; i < getNumPlayers(); i++) {
+            if (getPlayer(i).getLife() <= 0) {
+                endWithMessage("Player is dead. Better luck next time... -_-");
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void NetworkGame::endWithMessage(const std::string& msg) {
+    showMessage(msg);
+    isRunning = false;
+}
+
+// Decided by the game's state once the tick is final (see finalize)
+void NetworkGame::onPlayerDeath() {
+    gameOver = true;
+}
+
+// The answer is an input of the riddle's player: until it comes back on a tick, the player stands
+// at the riddle. This client asks its own player, once per answer on its way
+bool NetworkGame::getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) {
+    TickInput input = inputs[player].at(gameCycles);
+    if (input.riddle != TickInput::NO_ANSWER) {
+        outSolved = input.riddle == 1;
+        return true;
+    }
+
+    outSolved = false;
+    Direction dir = getPlayer(player).getDir();
+    if (player == me && pendingAnswer == TickInput::NO_ANSWER && gameCycles > askAgainAfter && dir <= UP) {
+        Riddle asked = *riddle;         // the riddle itself changes when the answer is simulated
+        pendingAnswer = asked.solve() ? 1 : 0;
+        answerKey = getPlayer(player).getKeys()[dir];
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "GameBase.h"
+#include "GameSave.h"
+#include "NetLink.h"
+#include "Steps.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+// File: NetworkGame.h
+// Description:
+//   A two-player game where every player runs a client of its own (-host / -join, on this machine).
+//   Both clients simulate the whole game and only exchange inputs: each tick a client sends the key
+//   its player pressed (and a riddle answer) for the tick INPUT_DELAY ticks ahead, so on a quick
+//   connection the other client has it before it needs it.
+//   An input that is late is predicted (nothing new) and the game goes on. When it arrives and
+//   differs, the game goes back to the save of that tick (see GameSave.h) and simulates the ticks
+//   since with the real inputs - the picture catches up within the same frame.
+//   A client never runs more than ROLLBACK_TICKS ahead of the inputs it has; beyond that it waits.
+//   Every STATE_HASH_INTERVAL ticks the clients compare the state both agree on - a difference
+//   means the simulation is not deterministic and ends the game.
+//   Riddles are answered by their player's own client; the answer is an input like a key.
+
+constexpr int NET_PORT = 47047;
+constexpr int INPUT_DELAY = 2;          // ticks between pressing a key and its tick
+constexpr int ROLLBACK_TICKS = 8;       // ticks simulated ahead of the other player's inputs at most
+constexpr int NET_HELLO_WAIT_MS = 10000;
+
+class NetworkGame : public GameBase {
+private:
+    bool hosting;
+    int me;                             // the player of this client (the host plays player 1)
+    NetLink link;
+    std::string inbox;                  // received, not parsed yet
+
+    InputChannel inputs[2];             // per player
+    size_t firstTick = 1;
+    GameSave saves[ROLLBACK_TICKS + 1]; // state at the start of the latest ticks (by tick)
+    size_t rollbackFrom = 0;            // earliest tick simulated with a wrong prediction (0 - none)
+    size_t finalTick = 0;               // ticks up to here are simulated with every real input
+
+    char pendingKey = 0;                // goes out with the next input
+    signed char pendingAnswer = TickInput::NO_ANSWER;
+    char answerKey = 0;                 // the step into the riddle, repeated with the answer
+    size_t askAgainAfter = 0;           // an answer is on its way until this tick
+    bool leaving = false;
+
+    std::map<size_t, std::uint64_t> myHashes;       // final state hashes, not compared yet
+    std::map<size_t, std::uint64_t> theirHashes;
+
+    GameSave& saveOf(size_t tick) { return saves[tick % (ROLLBACK_TICKS + 1)]; }
+    bool handshake();
+    bool receiveAll();                  // false once the other player left or broke the protocol
+    bool sendInput(size_t tick);
+    void simulate(size_t tick, bool save);
+    void rollback();
+    bool finalize();                    // false on a state mismatch
+    void endWithMessage(const std::string& msg);
+
+protected:
+    void tick() override;
+    void handleInput() override;        // this client's key for the next input
+    void onGameEnd() override {}
+    void onPlayerDeath() override;
+    int getDelay() const override { return KEYBOARD_DELAY; }
+    bool getRiddleAnswer(Riddle* riddle, int player, bool& outSolved) override;
+
+public:
+    explicit NetworkGame(bool host);
+    ~NetworkGame();
+
+    bool connect();                     // waits for / reaches the other client - false if cancelled or failed
+    void play();
+};
@@ -1,8 +1,48 @@
 #include "Obstacle.h"
 
+Obstacle::Obstacle(const Point* cells, int count, RoomArena* arena)
+    : mask(ArenaAllocator<std::uint64_t>(arena))
+{
+    if (count <= 0) return;
+
+    // bounding box of all cells
+    int minX = cells[0].getX(), maxX = minX;
+    int minY = cells[0].getY(), maxY = minY;
+    for (int i = 0; i < count; i++) {
+        const Point& p = cells[i];
+        minX = std::min(minX, p.getX());
+        maxX = std::max(maxX, p.getX());
+        minY = std::min(minY, p.getY());
+        maxY = std::max(maxY, p.getY());
+    }
+
+    origin = Point(minX, minY);
+    width = maxX - minX + 1;
+    height = maxY - minY + 1;
+    mask.assign((width * height + 63) / 64, 0);
+
+    for (int i = 0; i < count; i++) {
+        const Point& p = cells[i];
+        int bit = (p.getY() - minY) * width + (p.getX() - minX);
+        mask[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+    }
+    cellCount = count;
+}
+
+Obstacle::Obstacle(const Obstacle& other, RoomArena* arena)
+    : origin(other.origin), width(other.width), height(other.height), cellCount(other.cellCount),
+    mask(other.mask.begin(), other.mask.end(), ArenaAllocator<std::uint64_t>(arena)), figure(other.figure)
+{
+}
+
 // is p part of body
 bool Obstacle::isObBody(const Point& p) const {
-    return std::find(body.begin(), body.end(), p) != body.end();
+    int col = p.getX() - origin.getX();
+    int row = p.getY() - origin.getY();
+
+    if (col < 0 || row < 0 || col >= width || row >= height)
+        return false;
+    return testBit(col, row);
 }
 
 // checks if it has enough force to move this obstacle
@@ -15,16 +55,14 @@ void Obstacle::move(Direction dir) {
     if (dir == STAY || dir == DISPOSE)
         return;
 
-    for (Point& cell : body)
-        cell = cell.next(dir);
+    origin = origin.next(dir);
 }
 
-std::vector<Point> Obstacle::getNextBody(Direction dir) const {
-    std::vector<Point> result;
-    result.reserve(body.size());
+bool Obstacle::removeCell(const Point& p) {
+    if (!isObBody(p)) return false;
 
-    for (const Point& cell : body)
-        result.push_back(cell.next(dir));
-
-    return result;
-}
\ No newline at end of file
+    int bit = (p.getY() - origin.getY()) * width + (p.getX() - origin.getX());
+    mask[bit >> 6] &= ~(std::uint64_t(1) << (bit & 63));
+    cellCount--;
+    return true;
+}
@@ -1,31 +1,62 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include "Point.h"
 #include "GameDefs.h"
+#include "RoomArena.h"
 
+// An obstacle is stored as the origin (top-left) of its bounding box plus one bit per box cell,
+// so pushing it only moves the origin and membership tests are a bit lookup.
 class Obstacle{
 private: 
 
-	std::vector<Point> body;
+	Point origin;                       // top-left corner of the bounding box
+	int width = 0, height = 0;          // bounding box size
+	int cellCount = 0;                  // number of cells that are part of the body
+	ArenaVector<std::uint64_t> mask;    // bit (row * width + col) set if that cell is part of the body
 	char figure = '*';
 
+	bool testBit(int col, int row) const {
+		int bit = row * width + col;
+		return (mask[bit >> 6] >> (bit & 63)) & 1u;
+	}
+
  public:
-     Obstacle() : body() {}      // default ctor
-     explicit Obstacle(const std::vector<Point>& _body)  // custom ctor
-         : body(_body) {}
+     Obstacle() : mask() {}      // default ctor
+     Obstacle(const Point* cells, int count, RoomArena* arena);     // body made of the given cells (mask lives in the arena)
+     Obstacle(const Obstacle& other, RoomArena* arena);             // exact copy whose mask lives in another arena
 	 
      // Get Functions
-     std::vector<Point>& getBody() { return body; }    // Non-const & const access to obstacle body
-     const std::vector<Point>& getBody() const { return body; }   
-	 int getSize() const { return static_cast<int>(body.size()); }  // casting
+	 int getSize() const { return cellCount; }
+	 size_t getMaskWords() const { return mask.size(); }
      char getFigure() const { return figure; }
+	 bool isEmpty() const { return cellCount == 0; }
+	 Point getTopLeft() const { return origin; }      // bounding box
+	 Point getBottomRight() const { return Point(origin.getX() + width - 1, origin.getY() + height - 1); }
 
      bool isObBody(const Point& p) const;
      bool canBePushed(int force) const;
 
-     void move(Direction dir);
-     std::vector<Point> getNextBody(Direction dir) const;
-
-
+     void move(Direction dir);           // shifts the origin - O(1)
+     bool removeCell(const Point& p);    // returns false if p isn't part of the body
+
+	 template <typename Fn>
+	 void forEachCell(Fn fn) const {     // fn(cell) for every body cell, row by row
+		 for (int row = 0; row < height; row++)
+			 for (int col = 0; col < width; col++)
+				 if (testBit(col, row))
+					 fn(Point(origin.getX() + col, origin.getY() + row));
+	 }
+
+	 // fn(cell) for the body cells that move onto a new cell when pushed in dir (cell.next(dir) is outside the body)
+	 template <typename Fn>
+	 void forEachLeadingCell(Direction dir, Fn fn) const {
+		 forEachCell([&](const Point& cell) { if (!isObBody(cell.next(dir))) fn(cell); });
+	 }
+
+	 // fn(cell) for the body cells that are left empty when pushed in dir (nothing of the body follows into them)
+	 template <typename Fn>
+	 void forEachTrailingCell(Direction dir, Fn fn) const {
+		 forEachLeadingCell(Point::opposite(dir), fn);
+	 }
 };
-
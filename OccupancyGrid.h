@@ -0,0 +1,54 @@
+#pragma once
+#include "Point.h"
+#include "Utils.h"
+#include <vector>
+
+// Marks which player stands on each cell of a room (-1 if none).
+// The game keeps one per room so player-vs-player checks are a single lookup
+// instead of a pass over every other player.
+// The marked cells are remembered, so clearing or copying a grid costs as much as the players
+// on it - not the size of the room.
+class OccupancyGrid {
+private:
+    BoardSize size{ 0, 0 };
+    std::vector<signed char> cells;     // indexed by CellIndex
+    std::vector<CellIndex> marked;      // cells set since the last clear (may repeat)
+
+public:
+    // Sizes the grid for a room - only reallocates when the size changes
+    void fit(const BoardSize& room) {
+        if (room != size) {
+            size = room;
+            cells.assign(size.cells(), -1);
+            marked.clear();
+        }
+    }
+
+    void clear() {
+        for (CellIndex c : marked)
+            cells[c] = -1;
+        marked.clear();
+    }
+
+    void copyFrom(const OccupancyGrid& other) {
+        clear();
+        fit(other.size);
+        for (CellIndex c : other.marked) {
+            cells[c] = other.cells[c];
+            marked.push_back(c);
+        }
+    }
+
+    int at(const Point& p) const {
+        return size.contains(p) ? cells[size.cellOf(p)] : -1;
+    }
+    void set(const Point& p, int idx) {
+        if (!size.contains(p)) return;
+        CellIndex c = size.cellOf(p);
+        cells[c] = static_cast<signed char>(idx);
+        marked.push_back(c);
+    }
+    void remove(const Point& p, int idx) {   // only clears the cell if idx is still the one standing there
+        if (at(p) == idx) cells[size.cellOf(p)] = -1;
+    }
+};
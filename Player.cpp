@@ -14,11 +14,11 @@ void Player::setPlayer(const Point& _pos, char _figure, const char keys[6])
 	forcedDir = STAY;
 
 	speed = 1;
-	accelTimer = 0;
-	pushing = false;
+	accelerating = false;
+	accelTimer = TimerHandle{};
 
 	isDead = false;
-	respawnTimer = 5;
+	respawnTimer = TimerHandle{};
 
 	clearInventory();
 	life = 3;
@@ -57,7 +57,7 @@ void Player::setDir(const char ch)
 	else if (ch == arrowKeys[STAY]) requestDir = STAY;
 	else return;
 
-	if (accelTimer > 0)
+	if (accelerating)
 	{
 		// STAY is forbidden
 		if (requestDir == STAY)
@@ -81,13 +81,13 @@ Point Player::getNextPos() const
 	Point next = pos;
 
 	// forced movement (spring launch)
-	if (accelTimer > 0 && forcedDir != STAY)
+	if (accelerating && forcedDir != STAY)
 	{
 		next = next.next(forcedDir);
 	}
 
 	// sideways movement allowed (but not opposite)
-	if (accelTimer > 0)
+	if (accelerating)
 	{
 		if (dir != STAY && !Point::areOpposite(dir, forcedDir))
 			next = next.next(dir);
@@ -104,17 +104,14 @@ Point Player::getNextPos() const
 
 // Action Functions
 
-void Player::draw() const
+void Player::draw(const Viewport& view) const
 {
-	Utils::gotoxy(pos.getX(), pos.getY());
-	std::cout << figure;
-
+	view.put(pos, figure);
 }
 
-void Player::erase() const
+void Player::erase(const Viewport& view) const
 {
-	Utils::gotoxy(pos.getX(), pos.getY());
-	std::cout << ' ';
+	view.put(pos, ' ');
 }
 
 void Player::move()
@@ -129,26 +126,29 @@ void Player::move()
 
 void Player::accel(int force, Direction spDir) {  // Sets forced movement
 
-	speed = force;       // speed boost and direction for several steps.
-	accelTimer = force * force;
+	speed = force;       // speed boost and direction, the game times how long it lasts.
+	accelerating = true;
 	forcedDir = spDir;
 	dir = spDir;
 
 }
 
 // Handles collision between players.
-void Player::bumpedInto(Player& other) const {// *Logic reviewed with ChatGPT assistance*
+// Returns true if the acceleration was passed on - the caller then times the other
+// player's acceleration to end together with this one.
+bool Player::bumpedInto(Player& other) const {// *Logic reviewed with ChatGPT assistance*
 	// If the moving player is under spring acceleration:
 	if (this->isAccelerating())
 	{                              // transfer the same speed, direction and acceleration to the other player.
 		other.speed = this->speed;  
-		other.accelTimer = this->accelTimer;
+		other.accelerating = true;
 		other.forcedDir = this->forcedDir;
 		other.dir = this->forcedDir;   // ignore previous direction
 
 		// The moving player continues normally.
-		return;
+		return true;
 	}
+	return false;
 }
 
 
@@ -157,14 +157,14 @@ int Player::getAccelerationSubSteps(Point subSteps[MAX_SUB_STEPS]) const
 	int count = 0;
 
 	// 1) forced movement (always first)
-	if (accelTimer > 0 && forcedDir != STAY)
+	if (accelerating && forcedDir != STAY)
 	{
 		subSteps[count] = pos.next(forcedDir);
 		count++;
 	}
 
 	// 2) sideways movement (if allowed)
-	if (accelTimer > 0)
+	if (accelerating)
 	{
 		if (dir != STAY && !Point::areOpposite(dir, forcedDir))
 		{
@@ -177,32 +177,14 @@ int Player::getAccelerationSubSteps(Point subSteps[MAX_SUB_STEPS]) const
 	return count; // can be 0, 1 or 2
 }
 
-void Player::tickAcceleration()
-{
-	if (accelTimer > 0)
-	{
-		accelTimer--;
-		if (accelTimer == 0)
-		{
-			speed = 1;
-			forcedDir = STAY;
-		}
-	}
-}
-
-// Counts down respawn timer; restores player to start position when finished.
+// Called when the respawn timer expires; restores player to start position.
 void Player::respawn() {
 	if (!isDead)
 		return;             
 
-	if (respawnTimer > 0) {        
-		respawnTimer--;
-		return;
-	}
-
 	pos = startPos;
 	isDead = false;
-	respawnTimer = 20;  
+	respawnTimer = TimerHandle{};
 }
 
 
@@ -217,12 +199,12 @@ void Player::resetForRoom()
 	dir = STAY;         
 
 	speed = 1;       
-	accelTimer = 0;      
+	accelerating = false;      
+	accelTimer = TimerHandle{};
 	forcedDir = STAY;    
 
 	isDead = false;     
-	respawnTimer = 5;   
-	pushing = false;
+	respawnTimer = TimerHandle{};
 
 	clearInventory();
 
@@ -2,6 +2,8 @@
 #include "Utils.h"
 #include "Point.h"
 #include "GameDefs.h"
+#include "TimerWheel.h"
+#include "Viewport.h"
 
 class Player {
 private:
@@ -13,15 +15,15 @@ private:
 	Direction dir = STAY;   // Current movement direction
 
 	int speed = 1;         // Steps per movement action
-	int accelTimer = 0;      // Remaining forced-movement duration
+	bool accelerating = false;   // True while forced movement is active
 	Direction forcedDir = STAY;  // Direction used during acceleration
+	TimerHandle accelTimer;      // Ends the forced movement (scheduled by the game)
 
 	bool isDead = false;         // True if player is in dead state
-	int respawnTimer = 20;        // Countdown until respawn
+	TimerHandle respawnTimer;    // Brings the player back (scheduled by the game)
 
 	bool afterDispose = false;    // True if the player disposed an item
 	int compressedLinks = 0;      // compressed links counter (spring)
-	bool pushing = false;   // player movement is constrained by obstacle push
 	Point teleportPos;
 
 	int score = 0;   
@@ -42,14 +44,13 @@ public:
 	void setDead() { isDead = true; }
 	void setDisposeFlag(bool val) { afterDispose = val; } 
 	void setTeleportPos(const Point& p) { teleportPos = p; }
-	bool isPushing() const { return pushing; }
-	void setPushing(bool v) { pushing = v; }
 
 	// Get Functions
 	Point& getPos() { return pos; }
 	const Point& getPos() const { return pos; }   // Non-const access to player's position
 	Point getNextPos() const;
 	char getFigure() const { return figure; }
+	std::string getKeys() const { return std::string(arrowKeys, arrowKeys + NUM_PLAYER_KEYS); }
 	int getSpeed() const { return speed; }
 	Direction getDir() const { return dir; }
 	bool getDead() const { return isDead; }
@@ -57,21 +58,29 @@ public:
 	Point& getTeleportPos() { return teleportPos; };
 
 	// Action Functions
-	void draw() const;
-	void erase() const;
+	void draw(const Viewport& view) const;     // nothing if the player is outside the view
+	void erase(const Viewport& view) const;
 	void move();
 	void accel(int force, Direction spDir);
 
-	bool isAccelerating() const { return accelTimer > 0; }
+	bool isAccelerating() const { return accelerating; }
 	void stopAcceleration() {
-		accelTimer = 0;
+		accelerating = false;
 		forcedDir = STAY;
 		speed = 1;
 	}
+	// The acceleration's time is up: the forced direction ends, the speed lasts one more run of steps
+	void endAcceleration() {
+		accelerating = false;
+		forcedDir = STAY;
+	}
+
+	// Timers owned by the game's timer wheel
+	TimerHandle& getAccelTimer() { return accelTimer; }
+	TimerHandle& getRespawnTimer() { return respawnTimer; }
 
-	void bumpedInto(Player& other) const;
+	bool bumpedInto(Player& other) const;
 	int getAccelerationSubSteps(Point subSteps[MAX_SUB_STEPS]) const;
-	void tickAcceleration();
 	void respawn();
 	char getInventoryChar() const;
 
@@ -80,15 +89,15 @@ public:
 	// Inventory Functions
 	bool inventoryEmpty() const { return inventory.type == NONE; }
 	ItemType checkItem() const { return inventory.type; }
-	int getIndex() const { return inventory.Index; }
+	const EntityHandle& getItemHandle() const { return inventory.handle; }
 	void clearInventory() // Removes any item the player carries.
 	{
 		inventory.type = NONE;
-		inventory.Index = -1;
+		inventory.handle = EntityHandle{};
 	}      
-	void collectItem(const ItemType& newItem, const int index = -1) { // Stores a new item in player's inventory  
+	void collectItem(const ItemType& newItem, const EntityHandle& handle = EntityHandle{}) { // Stores a new item in player's inventory  
 		inventory.type = newItem; 
-		inventory.Index = index;   // remembers its source index
+		inventory.handle = handle;   // remembers its source object
 	}
 	bool isDisposeKey(char c) const { return c == arrowKeys[DISPOSE]; }  // Returns True if player pressed the Dispose key
 
@@ -106,7 +115,6 @@ public:
 	bool lowerLife() { // no more set dead func
 		life--;
 		isDead = true;
-		respawnTimer = 20;
 		return life > 0;
 	}
 
@@ -1,40 +1,77 @@
 #pragma once
 #include "GameDefs.h"
+#include <cstdint>
+
+// Linear index of a cell inside a room (y * width + x, see BoardSize).
+// Only meaningful for points inside the room - used by the per-cell grids.
+using CellIndex = std::uint32_t;
+constexpr int NUM_CELLS = SCREEN_WIDTH * SCREEN_HEIGHT;     // cells of a standard room (the size of the terminal)
+constexpr int MAX_ROOM_SIDE = 4096;                         // largest width / height a screen file may declare
+
+// One step in every Direction (RIGHT, DOWN, LEFT, UP, STAY, DISPOSE)
+constexpr int DIR_DX[] = { 1, 0, -1, 0, 0, 0 };
+constexpr int DIR_DY[] = { 0, 1, 0, -1, 0, 0 };
 
 // Represents a 2D position on the screen/board.
+// Both coordinates are packed into 16 bits, so a Point is a single 32-bit word -
+// cheap to copy, and comparing two points is one integer compare.
 class Point
 {
 private:
-	int x, y;   // coordinates
+	std::int16_t x, y;   // coordinates
+
+	constexpr std::uint32_t packed() const {
+		return static_cast<std::uint16_t>(x) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(y)) << 16);
+	}
 
 public:
-	Point() { x = y = 0; };
+	constexpr Point() : x(0), y(0) {}
 
-	Point(const int _x, const int _y) : x(_x), y(_y) {};
+	constexpr Point(const int _x, const int _y)
+		: x(static_cast<std::int16_t>(_x)), y(static_cast<std::int16_t>(_y)) {}
 
-	bool operator==(const Point& other) const {
-		return x == other.x && y == other.y;
+	constexpr bool operator==(const Point& other) const {
+		return packed() == other.packed();
 	}
-	bool operator!=(const Point& other) const {
+	constexpr bool operator!=(const Point& other) const {
 		return !(*this == other);
 	}
-	int getX() const { return x; }
-	int getY() const { return y; }
+	constexpr int getX() const { return x; }
+	constexpr int getY() const { return y; }
 
 	bool operator<(const Point& other) const {
 		if (y != other.y) return y < other.y;
 		return x < other.x;
 	}
 
-	bool isAt(const Point& p) const {   // Comparing positions
-		return x == p.getX() &&
-			y == p.getY();
+	constexpr bool isAt(const Point& p) const {   // Comparing positions
+		return *this == p;
 	}
 
-	Point next(Direction dir) const;             // Returns the next position when moving one step in the given direction.
-	static bool checkLimits(const Point& p);     // Checks whether a point is inside the screen limits. 
+	// Returns the position 'steps' cells away in the given direction (one step by default).
+	constexpr Point next(Direction dir, int steps = 1) const {
+		return Point(x + DIR_DX[dir] * steps, y + DIR_DY[dir] * steps);
+	}
 	static bool areOpposite(Direction d1, Direction d2);   // Returns true if two directions are opposite to each other.
 	static Direction opposite(Direction dir);
 
 	
 };
+static_assert(sizeof(Point) == 4, "Point is expected to pack into one 32-bit word");
+
+// Size of a room's board. Standard rooms are as large as the terminal, a screen file may declare
+// a larger one (then only a window of it is shown, see Viewport.h). Cells are stored row by row.
+struct BoardSize {
+	int width = SCREEN_WIDTH;
+	int height = SCREEN_HEIGHT;
+
+	constexpr int cells() const { return width * height; }
+	constexpr bool isStandard() const { return width == SCREEN_WIDTH && height == SCREEN_HEIGHT; }
+	constexpr bool contains(const Point& p) const {
+		return p.getX() >= 0 && p.getX() < width && p.getY() >= 0 && p.getY() < height;
+	}
+	constexpr CellIndex cellOf(const Point& p) const { return static_cast<CellIndex>(p.getY() * width + p.getX()); }
+	constexpr Point pointOf(CellIndex c) const { return Point(static_cast<int>(c % width), static_cast<int>(c / width)); }
+	bool operator==(const BoardSize& other) const { return width == other.width && height == other.height; }
+	bool operator!=(const BoardSize& other) const { return !(*this == other); }
+};
@@ -0,0 +1,595 @@
+#include "Recording.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    constexpr char MAGIC[4] = { 'A', 'W', 'R', 'C' };
+    constexpr unsigned char VERSION = 2;            // 2: a content hash per room
+    constexpr std::uint64_t FLAG_STATE_HASHES = 1;
+
+    // ----- Writing -----
+    void putVarint(std::vector<unsigned char>& out, std::uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<unsigned char>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(v));
+    }
+
+    void putU64(std::vector<unsigned char>& out, std::uint64_t v) {
+        for (int i = 0; i < 8; i++)
+            out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+    }
+
+    void putString(std::vector<unsigned char>& out, const std::string& s) {
+        putVarint(out, s.size());
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    std::uint64_t zigzag(std::int64_t v) {
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+    std::int64_t unzigzag(std::uint64_t v) {
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    std::int64_t delta(size_t iteration, size_t last) {
+        return static_cast<std::int64_t>(iteration) - static_cast<std::int64_t>(last);
+    }
+
+    int bitsFor(size_t maxCode) {
+        int bits = 0;
+        while ((static_cast<size_t>(1) << bits) <= maxCode)
+            bits++;
+        return bits;
+    }
+
+    // ----- Reading -----
+    // Bounds-checked cursor over a byte range - after the first bad read ok() stays false
+    class ByteReader {
+    private:
+        const unsigned char* pos;
+        const unsigned char* end;
+        bool good = true;
+
+    public:
+        ByteReader(const char* data, size_t size)
+            : pos(reinterpret_cast<const unsigned char*>(data)), end(pos + size) {}
+
+        bool ok() const { return good; }
+        size_t left() const { return static_cast<size_t>(end - pos); }
+
+        std::uint64_t varint() {
+            std::uint64_t v = 0;
+            for (int shift = 0; good && shift < 64; shift += 7) {
+                if (pos == end) break;
+                unsigned char b = *pos++;
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            good = false;
+            return 0;
+        }
+
+        unsigned char byte() {
+            if (!good || pos == end) {
+                good = false;
+                return 0;
+            }
+            return *pos++;
+        }
+
+        std::uint64_t u64() {
+            std::uint64_t v = 0;
+            for (int i = 0; i < 8; i++)
+                v |= static_cast<std::uint64_t>(byte()) << (8 * i);
+            return v;
+        }
+
+        size_t size() {                 // a count / length - never more than the bytes left
+            std::uint64_t v = varint();
+            if (v > left()) {
+                good = false;
+                return 0;
+            }
+            return static_cast<size_t>(v);
+        }
+
+        std::string string() {
+            size_t n = size();
+            if (!good) return std::string();
+            std::string s(reinterpret_cast<const char*>(pos), n);
+            pos += n;
+            return s;
+        }
+
+        void skip(size_t n) {
+            if (!good || n > left()) {
+                good = false;
+                return;
+            }
+            pos += n;
+        }
+
+        size_t offsetFrom(const char* base) const {
+            return static_cast<size_t>(reinterpret_cast<const char*>(pos) - base);
+        }
+    };
+}
+
+// ----- Playback sources -----
+
+class Recording::BinaryStepSource : public StepSource {
+private:
+    std::shared_ptr<MappedFile> file;
+    std::string keys;               // every channel's keys, one after the other - a code is an index in it
+    int codeBits;
+    ByteReader bytes;
+    size_t left;
+    size_t iteration = 0;
+    std::string error;
+
+public:
+    BinaryStepSource(std::shared_ptr<MappedFile> _file, const std::vector<std::string>& channels, const Section& s)
+        : file(std::move(_file)), bytes(file->getData() + s.offset, s.length), left(s.count) {
+        for (const std::string& c : channels)
+            keys += c;
+        codeBits = bitsFor(keys.size());
+    }
+
+    bool next(size_t& outIteration, char& key) override {
+        if (left == 0)
+            return false;
+
+        std::uint64_t v = bytes.varint();
+        size_t code = static_cast<size_t>(v & ((static_cast<std::uint64_t>(1) << codeBits) - 1));
+        iteration += static_cast<size_t>(unzigzag(v >> codeBits));
+
+        if (code == keys.size())
+            key = static_cast<char>(bytes.byte());
+        else if (code < keys.size())
+            key = keys[code];
+        else {
+            error = "recording: step " + std::to_string(iteration) + " uses an unknown key";
+            return false;
+        }
+        if (!bytes.ok()) {
+            error = "recording: steps are cut short";
+            return false;
+        }
+
+        left--;
+        outIteration = iteration;
+        return true;
+    }
+
+    const std::string& getError() const override { return error; }
+};
+
+class Recording::BinaryResultSource : public ResultSource {
+private:
+    std::shared_ptr<MappedFile> file;
+    std::shared_ptr<std::vector<std::string>> strings;
+    ByteReader bytes;
+    size_t left;
+    size_t iteration = 0;
+    std::string error;
+
+    bool string(const std::string*& out) {
+        std::uint64_t id = bytes.varint();
+        if (id >= strings->size())
+            return false;
+        out = &(*strings)[static_cast<size_t>(id)];
+        return true;
+    }
+
+public:
+    BinaryResultSource(std::shared_ptr<MappedFile> _file, std::shared_ptr<std::vector<std::string>> _strings,
+        const Section& s)
+        : file(std::move(_file)), strings(std::move(_strings)),
+          bytes(file->getData() + s.offset, s.length), left(s.count) {}
+
+    bool next(Results& into) override {
+        if (left == 0)
+            return false;
+
+        using ResultType = Results::ResultType;
+        using ResultEntry = Results::ResultEntry;
+
+        std::uint64_t v = bytes.varint();
+        iteration += static_cast<size_t>(unzigzag(v >> 2));
+        ResultEntry entry(static_cast<ResultType>(v & 3));
+        bool good = true;
+
+        switch (entry.type) {
+        case ResultType::ScreenChange:
+            entry.screenId = static_cast<int>(unzigzag(bytes.varint()));
+            break;
+
+        case ResultType::LostLife:
+            break;
+
+        case ResultType::Riddle: {
+            const std::string* riddle = nullptr;
+            const std::string* answer = nullptr;
+            good = string(riddle) && string(answer);
+            if (good) {
+                entry.riddle = *riddle;
+                entry.answer = *answer;
+            }
+            entry.correct = bytes.byte() != 0;
+            break;
+        }
+
+        case ResultType::GameEnd:
+            entry.score = static_cast<int>(unzigzag(bytes.varint()));
+            break;
+        }
+
+        if (!good || !bytes.ok()) {
+            error = "recording: bad result entry at iteration " + std::to_string(iteration);
+            return false;
+        }
+        into.addResult(iteration, entry);
+        left--;
+        return true;
+    }
+
+    const std::string& getError() const override { return error; }
+};
+
+// ----- Recording -----
+
+bool Recording::open(const std::string& filename, std::string& errorMsg)
+{
+    file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        errorMsg = "Failed to open " + filename;
+        return false;
+    }
+
+    const char* base = file->getData();
+    ByteReader in(base, file->getSize());
+
+    char magic[4];
+    for (char& c : magic)
+        c = static_cast<char>(in.byte());
+    if (!in.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        errorMsg = filename + " is not a recording";
+        return false;
+    }
+    unsigned char version = in.byte();
+    if (version != VERSION) {
+        errorMsg = filename + ": unsupported version " + std::to_string(version);
+        return false;
+    }
+    std::uint64_t flags = in.varint();
+
+    screens.resize(in.size());
+    for (ScreenId& screen : screens) {
+        screen.file = in.string();
+        screen.hash = in.u64();
+        screen.hashed = true;
+    }
+
+    channels.resize(in.size());
+    for (std::string& keys : channels)
+        keys = in.string();
+
+    strings = std::make_shared<std::vector<std::string>>(in.size());
+    for (std::string& s : *strings)
+        s = in.string();
+
+    // Sections are only located here - their entries are decoded during playback
+    for (Section* s : { &stepSection, &resultSection }) {
+        s->count = in.size();
+        s->length = in.size();
+        s->offset = in.offsetFrom(base);
+        in.skip(s->length);
+    }
+
+    hashSection = Section();
+    if (flags & FLAG_STATE_HASHES) {
+        hashSection.count = in.size();
+        hashSection.offset = in.offsetFrom(base);
+        hashSection.length = in.left();
+    }
+
+    if (!in.ok()) {
+        errorMsg = filename + " is damaged or cut short";
+        return false;
+    }
+
+    hashPos = hashSection.offset;
+    hashesLeft = hashSection.count;
+    hashIteration = 0;
+    return true;
+}
+
+std::unique_ptr<StepSource> Recording::steps() const
+{
+    return std::unique_ptr<StepSource>(new BinaryStepSource(file, channels, stepSection));
+}
+
+std::unique_ptr<ResultSource> Recording::results() const
+{
+    return std::unique_ptr<ResultSource>(new BinaryResultSource(file, strings, resultSection));
+}
+
+bool Recording::nextStateHash(size_t& iteration, std::uint64_t& hash)
+{
+    if (hashesLeft == 0)
+        return false;
+
+    size_t end = hashSection.offset + hashSection.length;
+    ByteReader in(file->getData() + hashPos, end - hashPos);
+    hashIteration += static_cast<size_t>(in.varint());
+    hash = in.u64();
+    if (!in.ok()) {
+        hashesLeft = 0;
+        return false;
+    }
+
+    hashPos = end - in.left();
+    hashesLeft--;
+    iteration = hashIteration;
+    return true;
+}
+
+bool Recording::readScreensHeader(LineStream& text, std::vector<ScreenId>& screens, std::string& errorMsg)
+{
+    LineCursor line;
+    screens.clear();
+
+    // Expect header line: "# screens"
+    if (!text.nextLine(line) || line.text() != "# screens") {
+        errorMsg = "Screen header not found.";
+        return false;
+    }
+
+    // Read the rooms (one per line)
+    while (text.nextLine(line)) {
+        if (line.text().empty())
+            continue;
+        if (line.text()[0] == '#')
+            return true;
+        screens.push_back(ScreenId::fromLine(line.text().str()));
+    }
+    errorMsg = text.getError();
+    return errorMsg.empty();
+}
+
+bool Recording::pack(const std::string& stepsFile, const std::string& resultsFile, const std::string& recFile,
+    const std::vector<std::string>& channels, std::string& errorMsg)
+{
+    std::unique_ptr<LineStream> stepsText(new LineStream());
+    std::unique_ptr<LineStream> resultsText(new LineStream());
+    if (!stepsText->open(stepsFile) || !resultsText->open(resultsFile)) {
+        errorMsg = "Failed to open " + stepsFile + " / " + resultsFile;
+        return false;
+    }
+
+    std::vector<ScreenId> screens, resultScreens;
+    if (!readScreensHeader(*stepsText, screens, errorMsg) ||
+        !readScreensHeader(*resultsText, resultScreens, errorMsg))
+        return false;
+    if (!sameRooms(screens, resultScreens)) {
+        errorMsg = stepsFile + " and " + resultsFile + " list different screens";
+        return false;
+    }
+
+    // An older header only names the files - the rooms are taken as they are now
+    for (ScreenId& screen : screens) {
+        if (!screen.hashed && !ScreenId::hashFile(screen.file, screen.hash)) {
+            errorMsg = "Failed to open " + screen.file;
+            return false;
+        }
+        screen.hashed = true;
+    }
+
+    RecordingWriter writer(screens, channels);
+
+    // Every line is kept (repeated keys too), so unpacking gives back the same files
+    TextStepSource steps(std::move(stepsText));
+    size_t iteration;
+    char key;
+    while (steps.next(iteration, key))
+        writer.addStep(iteration, key);
+    if (!steps.getError().empty()) {
+        errorMsg = steps.getError();
+        return false;
+    }
+
+    TextResultSource resultLines(std::move(resultsText));
+    Results results;
+    while (resultLines.next(results)) {}
+    if (!resultLines.getError().empty()) {
+        errorMsg = resultLines.getError();
+        return false;
+    }
+    writer.addResults(results);
+
+    if (!writer.save(recFile)) {
+        errorMsg = "Failed to write " + recFile;
+        return false;
+    }
+    return true;
+}
+
+bool Recording::unpack(const std::string& recFile, const std::string& stepsFile, const std::string& resultsFile,
+    std::string& errorMsg)
+{
+    Recording rec;
+    if (!rec.open(recFile, errorMsg))
+        return false;
+
+    std::ofstream stepsOut(stepsFile);
+    std::ofstream resultsOut(resultsFile);
+    if (!stepsOut || !resultsOut) {
+        errorMsg = "Failed to write " + stepsFile + " / " + resultsFile;
+        return false;
+    }
+
+    stepsOut << "# screens\n";
+    resultsOut << "# screens\n";
+    for (const auto& screen : rec.screens) {
+        stepsOut << screen.line() << '\n';
+        resultsOut << screen.line() << '\n';
+    }
+
+    // Same layout as Steps::saveSteps() / Results::saveResults()
+    stepsOut << "# steps\n";
+    std::unique_ptr<StepSource> steps = rec.steps();
+    size_t iteration;
+    char key;
+    while (steps->next(iteration, key))
+        stepsOut << iteration << ' ' << key << '\n';
+
+    resultsOut << "# results\n";
+    std::unique_ptr<ResultSource> resultEntries = rec.results();
+    Results results;
+    while (resultEntries->next(results)) {
+        Results::writeEntry(resultsOut, results.results.front().first, results.results.front().second);
+        results.results.pop_front();
+    }
+
+    if (!steps->getError().empty() || !resultEntries->getError().empty()) {
+        errorMsg = steps->getError().empty() ? resultEntries->getError() : steps->getError();
+        return false;
+    }
+    return true;
+}
+
+// ----- RecordingWriter -----
+
+RecordingWriter::RecordingWriter(const std::vector<ScreenId>& _screens, const std::vector<std::string>& _channels)
+    : screens(_screens), channels(_channels)
+{
+    rawCode = 0;
+    for (const std::string& keys : channels)
+        rawCode += keys.size();
+    codeBits = bitsFor(rawCode);
+
+    std::fill(keyCode, keyCode + 256, rawCode);
+    size_t code = 0;
+    for (const std::string& keys : channels) {
+        for (char k : keys) {
+            size_t& slot = keyCode[static_cast<unsigned char>(k)];
+            if (slot == rawCode)
+                slot = code;
+            code++;
+        }
+    }
+}
+
+size_t RecordingWriter::intern(const std::string& text)
+{
+    auto it = std::lower_bound(stringIds.begin(), stringIds.end(), text,
+        [](const std::pair<std::string, size_t>& a, const std::string& b) { return a.first < b; });
+    if (it != stringIds.end() && it->first == text)
+        return it->second;
+
+    strings.push_back(text);
+    stringIds.insert(it, { text, strings.size() - 1 });
+    return strings.size() - 1;
+}
+
+void RecordingWriter::addStep(size_t iteration, char key)
+{
+    size_t code = keyCode[static_cast<unsigned char>(key)];
+    putVarint(stepBytes, (zigzag(delta(iteration, lastStep)) << codeBits) | code);
+    if (code == rawCode)
+        stepBytes.push_back(static_cast<unsigned char>(key));
+
+    lastStep = iteration;
+    stepCount++;
+}
+
+void RecordingWriter::addSteps(const Steps& steps)
+{
+    for (const auto& step : steps.getRecorded())
+        addStep(step.first, step.second);
+}
+
+void RecordingWriter::addResults(const Results& results)
+{
+    using ResultType = Results::ResultType;
+
+    for (const auto& entry : results.results) {
+        const Results::ResultEntry& res = entry.second;
+        putVarint(resultBytes, (zigzag(delta(entry.first, lastResult)) << 2) | static_cast<std::uint64_t>(res.type));
+
+        switch (res.type) {
+        case ResultType::ScreenChange:
+            putVarint(resultBytes, zigzag(res.screenId));
+            break;
+
+        case ResultType::LostLife:
+            break;
+
+        case ResultType::Riddle:
+            putVarint(resultBytes, intern(res.riddle));
+            putVarint(resultBytes, intern(res.answer));
+            resultBytes.push_back(res.correct ? 1 : 0);
+            break;
+
+        case ResultType::GameEnd:
+            putVarint(resultBytes, zigzag(res.score));
+            break;
+        }
+
+        lastResult = entry.first;
+        resultCount++;
+    }
+}
+
+void RecordingWriter::addStateHash(size_t iteration, std::uint64_t hash)
+{
+    putVarint(hashBytes, iteration - lastHash);
+    putU64(hashBytes, hash);
+    lastHash = iteration;
+    hashCount++;
+}
+
+bool RecordingWriter::save(const std::string& filename) const
+{
+    std::vector<unsigned char> out(MAGIC, MAGIC + sizeof(MAGIC));
+    out.push_back(VERSION);
+    putVarint(out, hashCount ? FLAG_STATE_HASHES : 0);
+
+    putVarint(out, screens.size());
+    for (const ScreenId& screen : screens) {
+        putString(out, screen.file);
+        putU64(out, screen.hash);
+    }
+
+    putVarint(out, channels.size());
+    for (const std::string& keys : channels)
+        putString(out, keys);
+
+    putVarint(out, strings.size());
+    for (const std::string& s : strings)
+        putString(out, s);
+
+    putVarint(out, stepCount);
+    putVarint(out, stepBytes.size());
+    out.insert(out.end(), stepBytes.begin(), stepBytes.end());
+
+    putVarint(out, resultCount);
+    putVarint(out, resultBytes.size());
+    out.insert(out.end(), resultBytes.begin(), resultBytes.end());
+
+    if (hashCount) {
+        putVarint(out, hashCount);
+        out.insert(out.end(), hashBytes.begin(), hashBytes.end());
+    }
+
+    std::FILE* f = std::fopen(filename.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return std::fclose(f) == 0 && ok;
+}
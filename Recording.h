@@ -0,0 +1,109 @@
+#pragma once
+#include "Steps.h"
+#include "Results.h"
+#include "MappedFile.h"
+#include "LineStream.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// File: Recording.h
+// Description:
+//   Compact binary container for a recorded game - the steps, the expected results and
+//   (optionally) periodic hashes of the game state, in one file.
+//
+//   Layout (integers are LEB128 varints unless noted):
+//     "AWRC" version(1 byte) flags(bit 0: state hashes)
+//     screens:  count, then per room <length><name> <content hash (8 bytes, LE)> (see ScreenId.h)
+//     channels: count, then <length><keys> per player - the keys a player's steps may use.
+//               A key's code is its place in all the channels' keys one after the other;
+//               one more code ("raw") stands for a key of no player
+//     strings:  count, then <length><text> - riddle questions / answers, each stored once
+//     steps:    count, byte length, then per step  ((zigzag(iteration delta) << codeBits) | code)
+//               with codeBits just wide enough for the raw code, which is followed by the key byte itself
+//     results:  count, byte length, then per entry ((zigzag(iteration delta) << 2) | type) + payload
+//               ScreenChange: zigzag(screen)  Riddle: question, answer (string ids), correct (1 byte)
+//               GameEnd: zigzag(score)        LostLife: nothing
+//     hashes:   count, then per hash <iteration delta> <hash (8 bytes, LE)>   (only with flag bit 0)
+//
+//   The file is mapped (see MappedFile.h) and read as the game goes, like the text files.
+
+class Recording {
+private:
+    class BinaryStepSource;
+    class BinaryResultSource;
+
+    struct Section {
+        size_t offset = 0;
+        size_t length = 0;
+        size_t count = 0;
+    };
+
+    std::shared_ptr<MappedFile> file;
+    std::vector<ScreenId> screens;
+    std::vector<std::string> channels;
+    std::shared_ptr<std::vector<std::string>> strings;
+    Section stepSection, resultSection, hashSection;
+
+    // State hash cursor
+    size_t hashPos = 0;
+    size_t hashesLeft = 0;
+    size_t hashIteration = 0;
+
+public:
+    static constexpr const char* DEFAULT_FILE = "adv-world.rec";
+
+    bool open(const std::string& filename, std::string& errorMsg);
+
+    const std::vector<ScreenId>& getScreens() const { return screens; }
+    const std::vector<std::string>& getChannels() const { return channels; }
+
+    // Playback sources - read straight from the mapping, only as far as the game got
+    std::unique_ptr<StepSource> steps() const;
+    std::unique_ptr<ResultSource> results() const;
+
+    // Next recorded state hash - false when there are none (left)
+    bool nextStateHash(size_t& iteration, std::uint64_t& hash);
+
+    // Reads the "# screens" header of a text steps / results file, up to the next '#' line
+    static bool readScreensHeader(LineStream& text, std::vector<ScreenId>& screens, std::string& errorMsg);
+
+    // Lossless conversion between the text files (steps + results) and a recording.
+    // channels: keys of each player (see RecordingWriter)
+    static bool pack(const std::string& stepsFile, const std::string& resultsFile, const std::string& recFile,
+        const std::vector<std::string>& channels, std::string& errorMsg);
+    static bool unpack(const std::string& recFile, const std::string& stepsFile, const std::string& resultsFile,
+        std::string& errorMsg);
+};
+
+// Builds a recording in memory and writes it in one go
+class RecordingWriter {
+private:
+    std::vector<ScreenId> screens;
+    std::vector<std::string> channels;
+    size_t keyCode[256];                    // key -> code (rawCode if no player has it)
+    size_t rawCode;
+    int codeBits;
+
+    std::vector<std::string> strings;
+    std::vector<std::pair<std::string, size_t>> stringIds;   // sorted by text, for interning
+
+    std::vector<unsigned char> stepBytes, resultBytes, hashBytes;
+    size_t stepCount = 0, resultCount = 0, hashCount = 0;
+    size_t lastStep = 0, lastResult = 0, lastHash = 0;
+
+    size_t intern(const std::string& text);
+
+public:
+    // channels: one string of keys per player. A key shared by two players gets the code of the first one.
+    RecordingWriter(const std::vector<ScreenId>& _screens, const std::vector<std::string>& _channels);
+
+    void addStep(size_t iteration, char key);
+    void addSteps(const Steps& steps);
+    void addResults(const Results& results);
+    void addStateHash(size_t iteration, std::uint64_t hash);
+
+    bool save(const std::string& filename) const;
+};
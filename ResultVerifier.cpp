@@ -0,0 +1,83 @@
+#include "ResultVerifier.h"
+#include <sstream>
+
+std::string ResultVerifier::describe(size_t iteration, const Results::ResultEntry& res)
+{
+    std::ostringstream line;
+    Results::writeEntry(line, iteration, res);
+    std::string text = line.str();
+    text.pop_back();            // line break
+    return text;
+}
+
+void ResultVerifier::check(size_t iteration, const Results::ResultEntry& actual)
+{
+    if (hasFailed())
+        return;
+
+    if (expected->results.empty() && !expected->readNext()) {
+        std::string readError = expected->getReadError();
+        fail(readError.empty() ? "Number of results mismatch" : readError, describe(iteration, actual));
+        return;
+    }
+
+    const auto& exp = expected->results.front();
+
+    // Check that the event occurred at the same game cycle
+    if (exp.first != iteration) {
+        fail("Iteration mismatch: expected " + std::to_string(exp.first) +
+            ", got " + std::to_string(iteration), describe(iteration, actual));
+        return;
+    }
+    // Check that the logical result is the same
+    if (!(exp.second == actual)) {
+        fail("Result mismatch at iteration " + std::to_string(iteration), describe(iteration, actual));
+        return;
+    }
+
+    recent.push_back(describe(exp.first, exp.second));
+    if (recent.size() > CONTEXT_EVENTS)
+        recent.pop_front();
+    expected->results.pop_front();
+}
+
+void ResultVerifier::checkMissingBefore(size_t iteration)
+{
+    if (hasFailed() || (expected->results.empty() && !expected->readNext()))
+        return;
+
+    size_t due = expected->results.front().first;
+    if (due < iteration)
+        fail("Result missing at iteration " + std::to_string(due), "(none)");
+}
+
+bool ResultVerifier::finish()
+{
+    if (!hasFailed() && !expected->atEnd())
+        fail("Number of results mismatch", "(none)");
+    return !hasFailed();
+}
+
+void ResultVerifier::fail(const std::string& what, const std::string& got)
+{
+    failure = what;
+
+    std::ostringstream out;
+    out << "Expected: ";
+    if (!expected->results.empty())
+        out << describe(expected->results.front().first, expected->results.front().second);
+    else
+        out << "(none)";
+    out << "\nGot:      " << got << '\n';
+
+    out << "Preceding events:\n";
+    if (recent.empty())
+        out << "  (none)\n";
+    for (const std::string& line : recent)
+        out << "  " << line << '\n';
+
+    out << "Players:";
+    if (dumpState)
+        out << dumpState();
+    report = out.str();
+}
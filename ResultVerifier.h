@@ -0,0 +1,53 @@
+#pragma once
+#include "Results.h"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+// File: ResultVerifier.h
+// Description:
+//   Checks the results of a replay against the recorded ones while the game runs.
+//   The expected results are read from their source in iteration order; every actual event is
+//   matched against the next expected one the moment the game produces it (see Results::setVerifier),
+//   so neither side piles up.
+//   The first mismatch is final: a report is kept with the events matched right before it and the
+//   players' state at that moment, and the replay can stop there instead of running to its end.
+
+class ResultVerifier {
+private:
+    std::unique_ptr<Results> expected;
+    std::function<std::string()> dumpState;     // players' state, for the report
+    std::deque<std::string> recent;             // last events that matched
+    std::string failure;
+    std::string report;
+
+    void fail(const std::string& what, const std::string& got);
+    static std::string describe(size_t iteration, const Results::ResultEntry& res);
+
+public:
+    static constexpr size_t CONTEXT_EVENTS = 5;
+
+    ResultVerifier(Results* _expected, std::function<std::string()> _dumpState)
+        : expected(_expected), dumpState(std::move(_dumpState)) {}
+
+    void check(size_t iteration, const Results::ResultEntry& actual);
+
+    // Start of a tick: every expected entry of an earlier tick must have been matched by now
+    void checkMissingBefore(size_t iteration);
+
+    // End of the replay - no expected results may be left. False on any mismatch
+    bool finish();
+
+    // Recorded riddle answer of this iteration. Earlier entries were consumed already, so only
+    // the current tick's entries are looked at
+    bool answerAt(size_t iteration, std::string& answer) { return expected->getRiddleAtIteration(iteration, answer); }
+
+    // Without verification: drops expected entries the game is already past
+    void skipBefore(size_t iteration) { expected->discardBefore(iteration); }
+
+    bool hasFailed() const { return !failure.empty(); }
+    const std::string& getFailure() const { return failure; }
+    const std::string& getReport() const { return report; }     // context of the failure (several lines)
+    const std::string& getReadError() const { return expected->getReadError(); }
+};
@@ -1,7 +1,8 @@
 #include "Results.h"
+#include "ResultVerifier.h"
 #include <fstream>
-#include <sstream>
 #include <iomanip>
+#include <sstream>
 
 
 bool Results::ResultEntry::operator==(const ResultEntry& other) const
@@ -29,38 +30,65 @@ bool Results::ResultEntry::operator==(const ResultEntry& other) const
 	return false;
 }
 
-Results* Results::loadResults(std::ifstream& file) {
-	Results* results = new Results();
-	std::string line;
-
-	// Read result entries line by line
-	while (std::getline(file, line)) {
-		if (line.empty())
+bool TextResultSource::next(Results& into) {
+	LineCursor line;
+	while (file->nextLine(line)) {
+		if (line.text().empty())
 			continue;  
 
 		// Parse single result entry
-		if (!results->parseResultLine(line)) {
-			delete results;
-			return nullptr;
+		if (!into.parseResultLine(line)) {
+			if (!file->isLineComplete())    // torn last write of a journal - the recording ends before it
+				return false;
+			error = file->getFilename() + " " + line.where() + ": bad result entry";
+			return false;
 		}
+		return true;
 	}
+	error = file->getError();
+	return false;
+}
+
+Results* Results::openResults(std::unique_ptr<ResultSource> from) {
+	Results* results = new Results();
+	results->source = std::move(from);
 	return results;
 }
 
-bool Results::parseResultLine(const std::string& line){
+bool Results::readNext() {
+	if (!source)
+		return false;
+
+	if (source->next(*this))
+		return true;
+
+	readError = source->getError();
+	source.reset();
+	return false;
+}
+
+bool Results::atEnd() {
+	return results.empty() && !readNext();
+}
+
+void Results::discardBefore(size_t iteration) {
+	while ((!results.empty() || readNext()) && results.front().first < iteration)
+		results.pop_front();
+}
+
+bool Results::parseResultLine(LineCursor& line){
 
-	std::istringstream iss(line);
 	size_t iteration;
-	std::string type;
+	TextView type;
 
 	// Parse common prefix: iteration + result type
-	if (!(iss >> iteration >> type)){
+	if (!(line.readSize(iteration) && line.readWord(type))){
 		return false;
 	}
 
 	if (type == "ScreenChange") {  // Screen changeP: <iteration> ScreenChange <screenId>
 		int screenId;
-		if (!(iss >> screenId))
+		if (!line.readInt(screenId))
 			return false;
 		addScreenChange(iteration, screenId);
 	}
@@ -69,7 +97,7 @@ bool Results::parseResultLine(const std::string& line){
 	}
 	else if (type == "GameEnd") {  // Game ended: <iteration> GameEnd <finalScore>
 		int finalScore;
-		if (!(iss >> finalScore))
+		if (!line.readInt(finalScore))
 			return false;
 		addGameEnd(iteration, finalScore);
 	}
@@ -77,7 +105,7 @@ bool Results::parseResultLine(const std::string& line){
 		std::string riddle, answer;      // <iteration> Riddle "<riddle>" "<answer>" <correct>
 		bool correct;
 
-		if (!(iss >> std::quoted(riddle) >> std::quoted(answer) >> correct))
+		if (!(line.readQuoted(riddle) && line.readQuoted(answer) && line.readBool(correct)))
 			return false;
 
 		addRiddleRes(iteration, riddle, answer, correct);
@@ -89,8 +117,11 @@ bool Results::parseResultLine(const std::string& line){
 	return true;
 }
 
-bool Results::getRiddleAtIteration(size_t iter, std::string& a) const
+bool Results::getRiddleAtIteration(size_t iter, std::string& a)
 {
+	// Entries of this iteration may not have been read yet
+	while ((results.empty() || results.back().first <= iter) && readNext()) {}
+
 	for (const auto& [it, e] : results) {
 		if (it == iter && e.type == ResultType::Riddle) {
 			a = e.answer;   // answer from file
@@ -101,7 +132,7 @@ bool Results::getRiddleAtIteration(size_t iter, std::string& a) const
 }
 
 bool Results::saveResults(const std::string& filename,
-	const std::vector<std::string>& screenFiles) const 
+	const std::vector<ScreenId>& screens) const 
 {
 	std::ofstream file(filename);    // Saves results to file (overwrites if exists).
 	if (!file)
@@ -109,40 +140,65 @@ bool Results::saveResults(const std::string& filename,
 
 	file << "# screens\n";
 	// Write screen files header to ensure replay consistency
-	for (const auto& name : screenFiles) {   
-		file << name << '\n';
+	for (const auto& screen : screens) {   
+		file << screen.line() << '\n';
 	}
 
 	// results header
 	file << "# results\n";
 	// Each entry: <iteration> <TYPE> <data...>
-	for (const auto& entry : results) {
-		size_t iteration = entry.first;
-		const ResultEntry& res = entry.second;
-
-		file << iteration << ' ';
-
-		switch (res.type) {
-		case ResultType::ScreenChange:
-			file << "ScreenChange" << ' ' 
-				<< res.screenId;
-			break;
-
-		case ResultType::LostLife:
-			file << "LostLife";
-			break;
-
-		case ResultType::Riddle:
-			file << "Riddle" << ' ' 
-				<< quoted(res.riddle) << ' ' << quoted(res.answer) << ' ' << res.correct;
-			break;
-
-		case ResultType::GameEnd:
-			file << "GameEnd" << ' ' 
-				<< res.score;
-			break;
-		}
-		file << '\n';
-	}
+	for (const auto& entry : results)
+		writeEntry(file, entry.first, entry.second);
 	return true;
 }
+
+void Results::startJournal(JournalWriter* to, const std::vector<ScreenId>& screens)
+{
+	// Same header as saveResults(), the entries follow as they are added
+	std::string header = "# screens\n";
+	for (const auto& screen : screens)
+		header += screen.line() + '\n';
+	header += "# results\n";
+
+	journal = to;
+	journal->append(header);
+}
+
+void Results::verify(size_t iteration, const ResultEntry& res)
+{
+	verifier->check(iteration, res);
+}
+
+void Results::journalEntry(size_t iteration, const ResultEntry& res)
+{
+	std::ostringstream line;
+	writeEntry(line, iteration, res);
+	journal->append(line.str());
+}
+
+void Results::writeEntry(std::ostream& out, size_t iteration, const ResultEntry& res)
+{
+	out << iteration << ' ';
+
+	switch (res.type) {
+	case ResultType::ScreenChange:
+		out << "ScreenChange" << ' ' 
+			<< res.screenId;
+		break;
+
+	case ResultType::LostLife:
+		out << "LostLife";
+		break;
+
+	case ResultType::Riddle:
+		out << "Riddle" << ' ' 
+			<< std::quoted(res.riddle) << ' ' << std::quoted(res.answer) << ' ' << res.correct;
+		break;
+
+	case ResultType::GameEnd:
+		out << "GameEnd" << ' ' 
+			<< res.score;
+		break;
+	}
+	out << '\n';
+}
@@ -1,11 +1,44 @@
 #pragma once
+#include "TextScanner.h"
+#include "LineStream.h"
+#include "JournalWriter.h"
+#include "ScreenId.h"
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <fstream>
 
+class Results;
+class ResultVerifier;
+
+// Where expected results come from - a text results file or a binary recording (see Recording.h)
+class ResultSource {
+public:
+    virtual ~ResultSource() = default;
+    virtual bool next(Results& into) = 0;               // appends the next entry - false at the end or on a bad entry
+    virtual const std::string& getError() const = 0;    // why reading stopped early (empty at the end)
+};
+
+// Results of a text results file (positioned after its header), one entry per line
+class TextResultSource : public ResultSource {
+private:
+    std::unique_ptr<LineStream> file;
+    std::string error;
+
+public:
+    explicit TextResultSource(std::unique_ptr<LineStream> _file) : file(std::move(_file)) {}
+    bool next(Results& into) override;
+    const std::string& getError() const override { return error; }
+};
+
 class Results {
 private:
+    friend class TextResultSource;
+    friend class RecordingWriter;
+    friend class Recording;
+    friend class ResultVerifier;
+
     enum class ResultType { ScreenChange, LostLife, Riddle, GameEnd };
 
     struct ResultEntry {
@@ -34,16 +67,31 @@ private:
     };
     std::list<std::pair<size_t, ResultEntry>> results;    // pair: <iteration, result entry>
 
-    bool parseResultLine(const std::string& line);
+    // Playback: 'results' only holds the entries read ahead but not consumed yet
+    std::unique_ptr<ResultSource> source;
+    std::string readError;
+
+    JournalWriter* journal = nullptr;   // save mode: every entry added from now on is appended to it
+    ResultVerifier* verifier = nullptr; // replay: entries are checked as they are added, not stored
+
+    bool parseResultLine(LineCursor& line);
+    void journalEntry(size_t iteration, const ResultEntry& res);
+    void verify(size_t iteration, const ResultEntry& res);
+    bool readNext();                    // appends the next entry of the source - false at its end
+    static void writeEntry(std::ostream& out, size_t iteration, const ResultEntry& res);   // one text line
 
 public:
     const std::list<std::pair<size_t, Results::ResultEntry>>&
         getResults() const { return results; }
 
-    bool getRiddleAtIteration(size_t iter, std::string& a) const;
+    bool getRiddleAtIteration(size_t iter, std::string& a);   // reads ahead up to iter if needed
 
     void addResult(size_t iteration, const ResultEntry& entry) {
+        if (verifier)
+            return verify(iteration, entry);
         results.push_back({ iteration, entry });
+        if (journal)
+            journalEntry(iteration, entry);
     }
 
     void addScreenChange(size_t iteration, int screenId){
@@ -60,8 +108,36 @@ public:
         addResult(iteration, ResultEntry(ResultType::Riddle, riddle, answer, correct));
     }
 
-    static Results* loadResults(std::ifstream& file);
+    // Moves all entries of 'other' to the end of this list (other is left empty)
+    void append(Results& other) {
+        if (verifier) {
+            for (const auto& entry : other.results)
+                verify(entry.first, entry.second);
+            other.clear();
+            return;
+        }
+        if (journal) {
+            for (const auto& entry : other.results)
+                journalEntry(entry.first, entry.second);
+        }
+        results.splice(results.end(), other.results);
+    }
+    void clear() { results.clear(); }
+
+    // Writes the file header to the journal, then every entry added from now on
+    void startJournal(JournalWriter* to, const std::vector<ScreenId>& screens);
+    void stopJournal() { journal = nullptr; }
+
+    // From now on every added entry goes to the verifier (see ResultVerifier.h)
+    void setVerifier(ResultVerifier* to) { verifier = to; }
+
+    // Starts reading expected results from a source - entries are read as they are needed
+    static Results* openResults(std::unique_ptr<ResultSource> from);
+
+    bool atEnd();                               // no expected entries left
+    void discardBefore(size_t iteration);       // expected entries that can no longer be asked for
+    const std::string& getReadError() const { return readError; }
     bool saveResults(const std::string& filename,
-        const std::vector<std::string>& screenFiles) const;
+        const std::vector<ScreenId>& screens) const;
 
 };
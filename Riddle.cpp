@@ -1,14 +1,9 @@
 #include "Riddle.h"
 
-void Riddle::setData(const std::string& q, const std::string& a)
-{
-    question = q;
-    answer = a;
-}
-
 void Riddle::printUI() const {     //function helped by GEMINI
     constexpr char BORDER = '?';
     const int  INDENT = 8;
+    const std::string question = getQuestion();
     const int WIDTH = (std::max)(static_cast<int>(question.length()) + 4, 44);
 
     auto printRow = [&](std::string const text = "", bool isLeftAlign = false) {
@@ -49,7 +44,7 @@ bool Riddle::solve() {
     std::string input;
     std::cin >> input;
 
-    bool isCorrect = matchRiddleAnswer(answer, input);
+    bool isCorrect = accepts(input);
 
     lastInput = input;
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Point.h"
+#include "RiddleStore.h"
 #include "Utils.h"
 #include <string>
 #include <iostream>
@@ -11,8 +12,7 @@ class Riddle {
 private:
     Point pos;
     char figure = '?';
-    std::string question;
-    std::string answer;
+    std::shared_ptr<const RiddleText> text;    // question and answers, shared with the store (see RiddleStore.h)
     bool solved = false;
     void printUI() const;
     std::string lastInput;
@@ -20,15 +20,14 @@ private:
 public:
     Riddle() : pos(0, 0)  {}
     explicit Riddle(Point p) : pos(p) {}
-    Riddle(Point p, int id, std::string q, std::string a)
-        : pos(p), question(std::move(q)), answer(std::move(a)) {}
 
-    void setData(const std::string& q, const std::string& a);
+    void setData(std::shared_ptr<const RiddleText> _text) { text = std::move(_text); }
     Point getPos() const { return pos; }
     char getFigure() const { return figure; }
     bool isSolved() const { return solved; }
-    std::string getAnswer() const { return answer; }
-    std::string getQuestion() const { return question; }
+    bool isShown() const { return !solved; }
+    bool accepts(const std::string& input) const { return text && text->accepts(input); }
+    std::string getQuestion() const { return text ? text->getQuestion() : std::string(); }
     std::string getLastInput() const { return lastInput; }
 
     bool solve();
@@ -0,0 +1,133 @@
+#include "RiddleStore.h"
+#include "GameDefs.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace {
+    // One riddles file entry: "<room> <x> <y>", then the question line and the answer line.
+    // Blank lines between entries are skipped. Returns false at the end of the file
+    // or on a broken entry (errorMsg then says where).
+    bool nextRiddleEntry(TextScanner& text, int& roomID, int& x, int& y,
+        TextView& question, TextView& answer, std::string& errorMsg)
+    {
+        LineCursor line;
+        do {
+            if (!text.nextLine(line))
+                return false;
+        } while (line.isBlank());
+
+        if (!(line.readInt(roomID) && line.readInt(x) && line.readInt(y))) {
+            errorMsg = std::string(RIDDLES_FILE) + " " + line.where() + ":\nexpected <room> <x> <y>";
+            return false;
+        }
+
+        LineCursor questionLine, answerLine;    // missing lines are read as empty
+        text.nextLine(questionLine);
+        text.nextLine(answerLine);
+        question = questionLine.text();
+        answer = answerLine.text();
+        return true;
+    }
+
+    bool byPosition(int roomA, const Point& a, int roomB, const Point& b) {
+        if (roomA != roomB) return roomA < roomB;
+        if (a.getY() != b.getY()) return a.getY() < b.getY();
+        return a.getX() < b.getX();
+    }
+}
+
+RiddleText::RiddleText(std::string _question, const std::string& answerLine) : question(std::move(_question))
+{
+    size_t start = 0;
+    while (start <= answerLine.length()) {
+        size_t end = answerLine.find('|', start);
+        if (end == std::string::npos)
+            end = answerLine.length();
+        if (end > start) {
+            std::string answer = Utils::toUpperCase(answerLine.substr(start, end - start));
+            hashes.insert(hashUpper(answer.data(), answer.length()));
+            answers.push_back(std::move(answer));
+        }
+        start = end + 1;
+    }
+}
+
+std::uint64_t RiddleText::hashUpper(const char* text, size_t length)
+{
+    std::uint64_t hash = Utils::HASH_SEED;
+    for (size_t i = 0; i < length; i++) {
+        char c = static_cast<char>(std::toupper(static_cast<unsigned char>(text[i])));
+        hash = Utils::hashBytes(&c, 1, hash);
+    }
+    return hash;
+}
+
+bool RiddleText::accepts(const std::string& input) const
+{
+    if (hashes.count(hashUpper(input.data(), input.length())) == 0)
+        return false;
+    // Same hash - make sure it is the same text
+    for (const std::string& answer : answers) {
+        if (answer.length() == input.length() && std::equal(answer.begin(), answer.end(), input.begin(),
+            [](char a, char b) { return a == static_cast<char>(std::toupper(static_cast<unsigned char>(b))); }))
+            return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const RiddleStore> RiddleStore::load(const std::string& file, std::string& errorMsg)
+{
+    static std::mutex lock;
+    static std::shared_ptr<const RiddleStore> latest;   // the store read last in this process
+
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        errorMsg = "Cannot load riddles file";
+        return nullptr;
+    }
+    std::uint64_t hash = Utils::hashBytes(mapped.getData(), mapped.getSize());
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (latest && latest->hash == hash)
+            return latest;
+    }
+
+    std::shared_ptr<RiddleStore> store = std::make_shared<RiddleStore>();
+    store->hash = hash;
+
+    TextScanner text = mapped.lines();
+    int roomID, x, y;
+    TextView question, answer;
+    while (nextRiddleEntry(text, roomID, x, y, question, answer, errorMsg))
+        store->entries.push_back({ roomID, Point(x, y), std::make_shared<RiddleText>(question.str(), answer.str()) });
+    if (!errorMsg.empty())
+        return nullptr;
+
+    std::stable_sort(store->entries.begin(), store->entries.end(), [](const Entry& a, const Entry& b) {
+        return byPosition(a.roomID, a.pos, b.roomID, b.pos); });
+
+    std::lock_guard<std::mutex> guard(lock);
+    latest = store;
+    return store;
+}
+
+bool RiddleStore::checkRooms(int numRooms, std::string& errorMsg) const
+{
+    for (const Entry& entry : entries) {
+        if (entry.roomID < ROOM1_SCREEN || entry.roomID > numRooms) {
+            errorMsg = "Rule refers to non-existing room " + std::to_string(entry.roomID) +
+                " at (" + std::to_string(entry.pos.getX()) + "," + std::to_string(entry.pos.getY()) + ")";
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t RiddleStore::firstOf(int roomID) const
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), roomID,
+        [](const Entry& entry, int id) { return entry.roomID < id; });
+    return static_cast<size_t>(it - entries.begin());
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Point.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// File: RiddleStore.h
+// Description:
+//   The riddles file, read once per game: every riddle by room and position, with its question and
+//   the answers it accepts. Rooms take their riddles from the store when they load or restart, so
+//   the file is not read again while the game goes on.
+//   An answer line lists the accepted answers between '|' ("|12|Twelve|"). They are upper-cased
+//   when the file is read and found by a hash of the typed text, so checking an answer allocates
+//   nothing.
+//   A store never changes once loaded: the games of a process that read the same file share one
+//   (see load), and a room's riddles point at their text instead of copying it.
+
+class RiddleText {
+private:
+    std::string question;
+    std::vector<std::string> answers;           // upper-cased
+    std::unordered_set<std::uint64_t> hashes;   // of each answer
+
+    static std::uint64_t hashUpper(const char* text, size_t length);
+
+public:
+    RiddleText(std::string _question, const std::string& answerLine);
+
+    const std::string& getQuestion() const { return question; }
+    bool accepts(const std::string& input) const;  // case doesn't matter
+};
+
+class RiddleStore {
+private:
+    struct Entry {
+        int roomID;
+        Point pos;
+        std::shared_ptr<const RiddleText> text;
+    };
+
+    std::uint64_t hash = 0;                     // of the file's content
+    std::vector<Entry> entries;                 // by room, then position
+    size_t firstOf(int roomID) const;           // index of the room's first riddle
+
+public:
+    // Reads the file - or shares the store of another game that read the same content
+    static std::shared_ptr<const RiddleStore> load(const std::string& file, std::string& errorMsg);
+
+    std::uint64_t getHash() const { return hash; }
+
+    // Checks every riddle names a room in 1..numRooms (errorMsg says which doesn't)
+    bool checkRooms(int numRooms, std::string& errorMsg) const;
+
+    // Calls apply(pos, text) for each riddle of the room, by position
+    template <typename Apply>
+    bool forRoom(int roomID, Apply apply) const {
+        for (size_t i = firstOf(roomID); i < entries.size() && entries[i].roomID == roomID; i++) {
+            if (!apply(entries[i].pos, entries[i].text))
+                return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,63 @@
+#include "RoomArena.h"
+
+namespace {
+    constexpr size_t MIN_BLOCK_SIZE = 4096;
+
+    size_t alignUp(size_t offset, size_t align) {
+        return (offset + align - 1) & ~(align - 1);
+    }
+}
+
+void RoomArena::addBlock(size_t size)
+{
+    Block b;
+    b.size = (size < MIN_BLOCK_SIZE) ? MIN_BLOCK_SIZE : size;
+    b.data.reset(new unsigned char[b.size]);
+    blocks.push_back(std::move(b));
+    used = 0;
+}
+
+void RoomArena::reserve(size_t bytes)
+{
+    if (blocks.size() == 1 && blocks[0].size >= bytes)
+        return;
+
+    blocks.clear();
+    addBlock(bytes);
+}
+
+void* RoomArena::allocate(size_t bytes, size_t align)
+{
+    if (blocks.empty())
+        addBlock(bytes + align);
+
+    // operator new[] memory is aligned for any fundamental type, so aligning the offset is enough
+    size_t offset = alignUp(used, align);
+    if (offset + bytes > blocks.back().size) {
+        // Out of room - overflow block twice the size of the last one (at least big enough for this)
+        size_t next = blocks.back().size * 2;
+        addBlock(next < bytes + align ? bytes + align : next);
+        offset = 0;
+    }
+
+    used = offset + bytes;
+    return blocks.back().data.get() + offset;
+}
+
+void RoomArena::release()
+{
+    if (blocks.size() > 1) {
+        size_t total = capacity();
+        blocks.clear();
+        addBlock(total);
+    }
+    used = 0;
+}
+
+size_t RoomArena::capacity() const
+{
+    size_t total = 0;
+    for (const Block& b : blocks)
+        total += b.size;
+    return total;
+}
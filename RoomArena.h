@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+#include <type_traits>
+
+// File: RoomArena.h
+// Description:
+//   Monotonic memory arena owned by a room. All entity storage of the room (SlotMaps, packed
+//   columns, obstacle bodies, dark areas, teleporters) is carved out of it by bumping an offset;
+//   single frees are no-ops and release() drops everything at once.
+//   The memory itself is kept for the next load of the room, so restarting a room does not
+//   go back to the general-purpose allocator once the arena was sized (see reserve()).
+
+class RoomArena {
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks;      // blocks[0] is the main block, the others are overflow
+    size_t used = 0;                // bytes used in the last block
+
+    void addBlock(size_t size);
+
+public:
+    RoomArena() = default;
+    RoomArena(const RoomArena&) = delete;
+    RoomArena& operator=(const RoomArena&) = delete;
+
+    // Makes sure the next load can be served from a single block of at least 'bytes'.
+    // Only call it while the arena is empty (right after release()).
+    void reserve(size_t bytes);
+
+    void* allocate(size_t bytes, size_t align);
+
+    // Everything allocated so far becomes invalid. Overflow blocks are merged into one main
+    // block so the next load of the same room fits without growing again.
+    void release();
+
+    size_t capacity() const;
+};
+
+// Standard allocator on top of a RoomArena, so the usual containers can live in it.
+// Without an arena it falls back to the global heap (default constructed containers).
+template <typename T>
+class ArenaAllocator {
+private:
+    RoomArena* arena = nullptr;
+
+    template <typename U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(RoomArena* _arena) : arena(_arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        if (arena)
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) {
+        if (!arena)             // arena memory is only given back by RoomArena::release()
+            ::operator delete(p);
+    }
+
+    RoomArena* getArena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
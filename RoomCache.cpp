@@ -0,0 +1,52 @@
+#include "RoomCache.h"
+
+RoomCache& RoomCache::shared()
+{
+    static RoomCache cache;
+    return cache;
+}
+
+bool RoomCache::find(const RoomKey& key, Screen& into, std::string& warningMsg)
+{
+    std::shared_ptr<const Screen> room;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = rooms.find(key);
+        if (it == rooms.end())
+            return false;
+        it->second.lastUse = ++useClock;
+        room = it->second.room;
+        warningMsg = it->second.warning;
+    }
+    into.copyFrom(*room);               // outside the lock - the cached room doesn't change
+    return true;
+}
+
+void RoomCache::add(const RoomKey& key, const Screen& room, const std::string& warningMsg)
+{
+    std::shared_ptr<Screen> copy = std::make_shared<Screen>();
+    copy->copyFrom(room);
+
+    std::lock_guard<std::mutex> guard(lock);
+    Entry& entry = rooms[key];
+    entry.lastUse = ++useClock;
+    if (!entry.room) {                  // another game may have parsed it meanwhile
+        entry.room = std::move(copy);
+        entry.warning = warningMsg;
+    }
+
+    if (rooms.size() > ROOM_CACHE_SIZE) {
+        auto oldest = rooms.begin();
+        for (auto it = rooms.begin(); it != rooms.end(); ++it) {
+            if (it->second.lastUse < oldest->second.lastUse)
+                oldest = it;
+        }
+        rooms.erase(oldest);            // a game still copying it holds its own reference
+    }
+}
+
+size_t RoomCache::size()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return rooms.size();
+}
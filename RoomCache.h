@@ -0,0 +1,56 @@
+#pragma once
+#include "Screen.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+// File: RoomCache.h
+// Description:
+//   Rooms as they are right after loading (screen file parsed, doors checked, riddles placed),
+//   shared by every game of the process (see shared()). The first game to enter a room parses it;
+//   restarts, later games, replays and the other sessions of a server (see GameServer.h) copy the
+//   parsed room instead of reading its files again. Cached rooms are never changed, so games copy
+//   them side by side.
+//   A room is known by the content hash of its screen file (see ScreenId.h) - an edited file is a
+//   new room, a renamed one is not - and by what its parse depends on: the riddles file, its room
+//   number, the number of rooms (doors are checked against it) and the number of players (the
+//   legend's size). At most ROOM_CACHE_SIZE rooms are kept, the least recently used one goes first.
+
+constexpr size_t ROOM_CACHE_SIZE = 64;
+
+struct RoomKey {
+    std::uint64_t content = 0;          // hash of the screen file
+    std::uint64_t riddles = 0;          // hash of the riddles file
+    int roomID = 0;
+    int numRooms = 0;
+    int numPlayers = 0;
+
+    bool operator<(const RoomKey& other) const {
+        return std::tie(content, riddles, roomID, numRooms, numPlayers) <
+            std::tie(other.content, other.riddles, other.roomID, other.numRooms, other.numPlayers);
+    }
+};
+
+class RoomCache {
+private:
+    struct Entry {
+        std::shared_ptr<const Screen> room;
+        std::string warning;            // of the load - every game shows it
+        size_t lastUse = 0;
+    };
+
+    std::mutex lock;
+    std::map<RoomKey, Entry> rooms;
+    size_t useClock = 0;
+
+public:
+    static RoomCache& shared();         // the one of this process
+
+    // Copies the cached room into 'into' - false if it is not cached
+    bool find(const RoomKey& key, Screen& into, std::string& warningMsg);
+    void add(const RoomKey& key, const Screen& room, const std::string& warningMsg);
+    size_t size();
+};
@@ -0,0 +1,276 @@
+#include "RoomCompiler.h"
+#include "Screen.h"
+
+namespace {
+    constexpr size_t MAX_ERROR_LINES = 4;   // what fits under the file name on the error screen
+}
+
+bool RoomCompiler::compile(TextScanner& text, const std::string& _filename, std::string& errorMsg, std::string& warningMsg)
+{
+    filename = _filename;
+
+    // The one pass over the characters
+    readSize(text);
+    screen.resize(size);
+    obstacleLabeler.begin(Point(0, 0), size.width);
+    readMap(text, warningMsg);
+    if (!screen.legend.exists)
+        addError("Legend is missing");
+
+    // Everything below works on what the pass collected
+    reserveStorage();
+    emitObjects();
+    emitSprings();
+    emitObstacles();
+
+    if (!errors.empty()) {
+        errorMsg = "Map from file: " + filename;
+
+        size_t shown = (errors.size() <= MAX_ERROR_LINES) ? errors.size() : MAX_ERROR_LINES - 1;
+        for (size_t i = 0; i < shown; i++)
+            errorMsg += "\n" + errors[i];
+        if (shown < errors.size())
+            errorMsg += "\n... and " + std::to_string(errors.size() - shown) + " more errors";
+        return false;
+    }
+
+    screen.clearLegendAreaFromBoard();      // legend is drawn there - not part of the playable board
+    screen.sourceFile = filename;
+    return true;
+}
+
+void RoomCompiler::readSize(TextScanner& text)
+{
+    // Optional header line - without it the map is a standard room (nothing is consumed)
+    TextScanner peek = text;
+    LineCursor cursor;
+    TextView word;
+    if (!peek.nextLine(cursor) || !cursor.readWord(word) || word != "SIZE")
+        return;
+    text = peek;
+
+    int width = 0, height = 0;
+    if (!cursor.readInt(width) || !cursor.readInt(height) || !cursor.atEnd() ||
+        width < 1 || width > MAX_ROOM_SIDE || height < 1 || height > MAX_ROOM_SIDE) {
+        addError("SIZE must be followed by a width and a height (1-" + std::to_string(MAX_ROOM_SIDE) + ")");
+        return;
+    }
+    size.width = width;
+    size.height = height;
+}
+
+void RoomCompiler::readMap(TextScanner& text, std::string& warningMsg)
+{
+    LineCursor cursor;
+    for (int y = 0; y < size.height; y++)
+    {
+        // Expect exactly one line per row (the board is already empty below a missing line)
+        if (!text.nextLine(cursor)) {
+            addError("Map has too few lines");
+            return;
+        }
+        TextView line = cursor.text();
+
+        // Each line must be wide enough - the missing part is taken as empty
+        if ((int)line.size < size.width)
+            addError("Line " + std::to_string(y) + " is too short");
+
+        for (int x = 0; x < size.width; x++)
+            compileCell((x < (int)line.size) ? line[x] : ' ', x, y, warningMsg);
+        obstacleLabeler.endRow();
+    }
+}
+
+void RoomCompiler::compileCell(char c, int x, int y, std::string& warningMsg)
+{
+    CellKind kind = cellTrait(c).kind;
+
+    if (kind == CELL_LEGEND) {
+        // Legend anchor must appear exactly once
+        if (screen.legend.exists) {
+            addError("Multiple legend anchors found");
+        }
+        else {
+            screen.setLegendAnchor(x, y);
+
+            // With more players the legend is taller and may not fit below its anchor
+            const LegendArea& legend = screen.legend;
+            if (!size.contains(legend.bottomRight)) {
+                addError("Invalid LEGEND placement: legend at (" + std::to_string(x) + "," +
+                    std::to_string(y) + ") does not fit on the screen.");
+                legendChecked = true;
+            }
+        }
+        c = ' ';                // legend cell is not part of the board
+        kind = CELL_EMPTY;
+    }
+    else if (kind == CELL_UNKNOWN) {
+        // Unknown character: replace with space and warn once
+        c = ' ';
+        kind = CELL_EMPTY;
+        if (warningMsg.empty())
+            warningMsg = "Map from file: " + filename + "\nUnknown characters were replaced with spaces";
+    }
+
+    CellIndex cell = size.cellOf(Point(x, y));
+    screen.board[cell] = c;
+    kindCount[kind]++;
+
+    switch (kind) {
+    case CELL_DOOR:
+    case CELL_KEY:
+    case CELL_BOMB:
+    case CELL_SWITCH:
+    case CELL_TORCH:
+    case CELL_RIDDLE:
+        objectCells.push_back(cell);
+        break;
+    case CELL_SPRING:
+        springCells.push_back(cell);
+        break;
+    default:
+        break;
+    }
+    obstacleLabeler.visit(x, kind == CELL_OBSTACLE);
+
+    // The whole legend area comes after its anchor, so it is checked as it streams by
+    if (screen.legend.exists && !legendChecked)
+        checkLegendCell(c, x, y);
+}
+
+void RoomCompiler::checkLegendCell(char c, int x, int y)
+{
+    // Legend may overlap only empty cells or outer walls
+    if (!screen.isLegendCell(Point(x, y)) || cellTrait(c).legendSafe)
+        return;
+
+    std::string msg = "Invalid LEGEND placement: overlaps forbidden object '";
+    msg += c;
+    msg += "' at position (" + std::to_string(x) + "," + std::to_string(y) + ").";
+    addError(msg);
+    legendChecked = true;
+}
+
+void RoomCompiler::reserveStorage()
+{
+    // The pass counted every object, so the room's arena can hold all of them in one block
+    size_t springCells = kindCount[CELL_SPRING];
+    size_t obstacleCells = kindCount[CELL_OBSTACLE];
+    size_t teleportCells = kindCount[CELL_TELEPORT];
+
+    size_t bytes = EntityStore<Door>::storageBytes(kindCount[CELL_DOOR])
+        + EntityStore<Key>::storageBytes(kindCount[CELL_KEY])
+        + EntityStore<Bomb>::storageBytes(kindCount[CELL_BOMB])
+        + EntityStore<Switch>::storageBytes(kindCount[CELL_SWITCH])
+        + EntityStore<Torch>::storageBytes(kindCount[CELL_TORCH])
+        + EntityStore<Riddle>::storageBytes(kindCount[CELL_RIDDLE])
+        + SlotMap<Spring>::storageBytes(springCells)          // at most one spring per cell
+        + SlotMap<Obstacle>::storageBytes(obstacleCells)
+        + obstacleCells * sizeof(std::uint64_t)              // bitmasks - at most a word per cell for usual shapes
+        + teleportCells * sizeof(TeleportPair);
+    // dark areas are only known from the data lines - if they overflow the block,
+    // release() folds the extra block in and the next load of the room fits again
+
+    screen.arena->reserve(bytes);
+
+    screen.doors.reserve(kindCount[CELL_DOOR]);
+    screen.keys.reserve(kindCount[CELL_KEY]);
+    screen.bombs.reserve(kindCount[CELL_BOMB]);
+    screen.switches.reserve(kindCount[CELL_SWITCH]);
+    screen.torches.reserve(kindCount[CELL_TORCH]);
+    screen.riddles.reserve(kindCount[CELL_RIDDLE]);
+    screen.springs.reserve(springCells);
+    screen.obstacles.reserve(obstacleCells);
+    screen.teleporters.reserve(teleportCells);
+}
+
+void RoomCompiler::emitObjects()
+{
+    // Creates the single-cell objects, in board order
+    for (CellIndex cell : objectCells)
+    {
+        Point p = size.pointOf(cell);
+        char c = screen.board[cell];
+
+        switch (cellTrait(c).kind) {
+        case CELL_DOOR:
+            screen.addDoor(Door(p, c - DIGIT_ZERO));
+            break;
+        case CELL_KEY:
+            screen.addKey(Key(p, -1));
+            break;
+        case CELL_BOMB:
+            screen.addBomb(Bomb(p));
+            break;
+        case CELL_SWITCH:
+            screen.addSwitch(Switch(p, -1, c == BOARD_SWITCH_ON));
+            break;
+        case CELL_TORCH:
+            screen.addTorch(Torch(p));
+            break;
+        case CELL_RIDDLE:
+            screen.addRiddle(Riddle(p));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void RoomCompiler::emitSprings()
+{
+    // Links that belong to a spring - a link left unmarked has no base
+    std::vector<bool> usedSpringCells(size.cells(), false);
+
+    for (CellIndex cell : springCells)
+    {
+        Point base = size.pointOf(cell);
+        Direction dir;
+        // Only build spring if this cell is a base (so it is at least 2 characters long)
+        if (!screen.isSpringBase(base.getX(), base.getY(), dir))
+            continue;
+
+        // Count spring length
+        int length = 0;
+        Point p = base;
+        while (size.contains(p) && screen.charAt(p) == BOARD_SPRING)
+        {
+            usedSpringCells[size.cellOf(p)] = true;
+            length++;
+            p = p.next(dir);
+        }
+        screen.addSpring(Spring(base, length, dir));
+    }
+
+    for (CellIndex cell : springCells)
+    {
+        if (usedSpringCells[cell])
+            continue;
+
+        int x = size.pointOf(cell).getX();
+        int y = size.pointOf(cell).getY();
+        bool hasAdjacentWall =
+            (y > 0 && screen.isWall({ x, y - 1 })) ||
+            (y < size.height - 1 && screen.isWall({ x, y + 1 })) ||
+            (x > 0 && screen.isWall({ x - 1, y })) ||
+            (x < size.width - 1 && screen.isWall({ x + 1, y }));
+
+        if (hasAdjacentWall)
+            addError("Spring", x, y, "must be at least 2 characters");
+        else
+            addError("Spring character", x, y, "is not attached to a wall");
+    }
+}
+
+void RoomCompiler::emitObstacles()
+{
+    // Groups of connected obstacle cells, labeled while the map was read
+    obstacleLabeler.finish([this](const Point* cells, int count) {
+        screen.addObstacle(Obstacle(cells, count, screen.arena.get()));
+    });
+}
+
+void RoomCompiler::addError(const std::string& what, int x, int y, const std::string& problem)
+{
+    addError(what + " at (" + std::to_string(x) + "," + std::to_string(y) + ") " + problem);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "BoardTraits.h"
+#include "ComponentLabeler.h"
+#include "Point.h"
+#include "TextScanner.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class Screen;
+
+// File: RoomCompiler.h
+// Description:
+//   Turns the map section of a screen file into a ready room in a single pass over its characters.
+//   Every character is classified once (BoardTraits.h) and the same pass writes the board, counts
+//   the objects for the room's arena, remembers where objects and springs are, feeds the obstacle
+//   labeler row by row and checks the legend area. Objects, springs and obstacles are then created
+//   from what was collected - the board itself is not scanned again.
+//   It does not stop at the first problem: every error of the map is reported in one message.
+//   A map is as large as the screen unless its first line is "SIZE <width> <height>".
+
+class RoomCompiler {
+private:
+    Screen& screen;
+    std::string filename;
+    std::vector<std::string> errors;
+
+    BoardSize size;
+    size_t kindCount[CELL_KIND_COUNT] = {};
+    std::vector<CellIndex> objectCells;     // single-cell objects, in board order
+    std::vector<CellIndex> springCells;     // spring links, in board order
+    ComponentLabeler obstacleLabeler;
+    bool legendChecked = false;             // report one legend problem at most
+
+    void readSize(TextScanner& text);
+    void readMap(TextScanner& text, std::string& warningMsg);
+    void compileCell(char c, int x, int y, std::string& warningMsg);
+    void checkLegendCell(char c, int x, int y);
+    void reserveStorage();
+    void emitObjects();
+    void emitSprings();
+    void emitObstacles();
+    void addError(const std::string& msg) { errors.push_back(msg); }
+    void addError(const std::string& what, int x, int y, const std::string& problem);
+
+public:
+    explicit RoomCompiler(Screen& _screen) : screen(_screen) {}
+
+    // Returns false if the map has errors - errorMsg then lists them (the first few, one per line)
+    bool compile(TextScanner& text, const std::string& _filename, std::string& errorMsg, std::string& warningMsg);
+};
@@ -0,0 +1,135 @@
+#include "RoomLoader.h"
+#include <algorithm>
+
+RoomLoader::~RoomLoader()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+void RoomLoader::reset(int count)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    queue.clear();
+
+    // The worker may still be writing into a room - wait until it is done with it
+    loaded.wait(guard, [&] {
+        return std::none_of(slots.begin(), slots.end(), [](const Slot& s) { return s.state == State::Loading; });
+    });
+
+    slots.assign(count, Slot());
+}
+
+void RoomLoader::markReady(int roomID)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    slots[roomID].state = State::Ready;
+    slots[roomID].lastUse = ++useClock;
+}
+
+void RoomLoader::touch(int roomID)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    slots[roomID].lastUse = ++useClock;
+}
+
+void RoomLoader::prefetch(int roomID)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (roomID < 0 || roomID >= static_cast<int>(slots.size()) || slots[roomID].state != State::Unloaded)
+            return;
+
+        slots[roomID].state = State::Queued;
+        queue.push_back(roomID);
+
+        if (!worker.joinable())         // the thread is only created on the first prefetch
+            worker = std::thread(&RoomLoader::workerLoop, this);
+    }
+    wake.notify_one();
+}
+
+bool RoomLoader::ensure(int roomID, std::string& errorMsg, std::string& warningMsg)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    Slot& slot = slots[roomID];
+
+    if (slot.state == State::Queued)    // not started yet - load it here rather than wait in line
+        queue.erase(std::find(queue.begin(), queue.end(), roomID));
+    if (slot.state == State::Queued || slot.state == State::Unloaded)
+        runLoad(roomID, guard);
+
+    loaded.wait(guard, [&] { return slot.state != State::Loading; });
+
+    warningMsg = slot.warning;
+    slot.warning.clear();               // shown once
+    errorMsg = slot.error;
+    slot.lastUse = ++useClock;
+    return slot.state == State::Ready;
+}
+
+int RoomLoader::trim(size_t budget, const std::function<bool(int roomID)>& keep)
+{
+    std::vector<int> victims;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t loadedRooms = std::count_if(slots.begin(), slots.end(), [](const Slot& s) {
+            return s.state != State::Unloaded && s.state != State::Failed; });
+        if (loadedRooms <= budget)
+            return 0;
+
+        // Only rooms at rest - the worker never touches a Ready room
+        for (int id = 0; id < static_cast<int>(slots.size()); id++) {
+            if (slots[id].state == State::Ready && !keep(id))
+                victims.push_back(id);
+        }
+        std::sort(victims.begin(), victims.end(), [&](int a, int b) { return slots[a].lastUse < slots[b].lastUse; });
+        victims.resize(std::min(victims.size(), loadedRooms - budget));
+    }
+
+    for (int id : victims)
+        unload(id);
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (int id : victims)
+        slots[id].state = State::Unloaded;
+    return static_cast<int>(victims.size());
+}
+
+void RoomLoader::runLoad(int roomID, std::unique_lock<std::mutex>& guard)
+{
+    slots[roomID].state = State::Loading;
+    guard.unlock();
+
+    std::string errorMsg, warningMsg;
+    bool ok = load(roomID, errorMsg, warningMsg);
+
+    guard.lock();
+    Slot& slot = slots[roomID];
+    slot.state = ok ? State::Ready : State::Failed;
+    slot.error = errorMsg;
+    slot.warning = warningMsg;
+    loaded.notify_all();
+}
+
+void RoomLoader::workerLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (true) {
+        wake.wait(guard, [&] { return stopping || !queue.empty(); });
+        if (stopping)
+            return;
+
+        int roomID = queue.front();
+        queue.pop_front();
+        runLoad(roomID, guard);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// File: RoomLoader.h
+// Description:
+//   Loads rooms when they are first needed instead of all before the game starts.
+//   prefetch() queues a room for a background thread (the rooms a player's doors lead to),
+//   ensure() makes sure a room is loaded before it is used - it takes the result of the
+//   prefetch, waits for a load already running, or loads the room itself.
+//   The load function must only touch the room it was given: the game keeps running meanwhile.
+//   trim() bounds how many rooms stay loaded: the least recently used ones the game doesn't need
+//   close by are handed to the unload function, and their next ensure() loads them again.
+
+class RoomLoader {
+public:
+    // Loads one room - false on error (errorMsg), warnings are handed to whoever ensure()s the room
+    using LoadFn = std::function<bool(int roomID, std::string& errorMsg, std::string& warningMsg)>;
+    // Takes a loaded room out of memory (called on the game's thread)
+    using UnloadFn = std::function<void(int roomID)>;
+
+private:
+    enum class State { Unloaded, Queued, Loading, Ready, Failed };
+
+    struct Slot {
+        State state = State::Unloaded;
+        size_t lastUse = 0;             // useClock when the room was last ensured / touched
+        std::string error;
+        std::string warning;
+    };
+
+    LoadFn load;
+    UnloadFn unload;
+    std::vector<Slot> slots;
+    size_t useClock = 0;
+    std::deque<int> queue;              // rooms waiting for the background thread
+
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable wake;       // the worker waits here for queued rooms
+    std::condition_variable loaded;     // ensure() waits here for a load the worker is running
+    bool stopping = false;
+
+    void workerLoop();
+    void runLoad(int roomID, std::unique_lock<std::mutex>& guard);   // lock is released while loading
+
+public:
+    RoomLoader(LoadFn _load, UnloadFn _unload) : load(std::move(_load)), unload(std::move(_unload)) {}
+    ~RoomLoader();
+    RoomLoader(const RoomLoader&) = delete;
+    RoomLoader& operator=(const RoomLoader&) = delete;
+
+    // Forgets every room (waits for a load in progress first) - count rooms, none loaded
+    void reset(int count);
+
+    void markReady(int roomID);         // a room set up without the load function (final room, restart)
+    void prefetch(int roomID);          // returns at once
+    void touch(int roomID);             // the room is in use - last to be unloaded
+
+    // Unloads least recently used rooms until at most 'budget' are loaded (or being loaded).
+    // Rooms keep() is true for stay. Returns the number of rooms unloaded
+    int trim(size_t budget, const std::function<bool(int roomID)>& keep);
+
+    // Blocks until the room is loaded. False if it failed (errorMsg). warningMsg gets the load's
+    // warnings the first time the room is ensured
+    bool ensure(int roomID, std::string& errorMsg, std::string& warningMsg);
+};
@@ -0,0 +1,109 @@
+#include "RoomSnapshot.h"
+
+namespace {
+    template <typename T, typename Store>
+    void copyOut(const Store& store, std::vector<T>& out) {
+        out.clear();
+        out.reserve(store.size());
+        for (const T& item : store)
+            out.push_back(item);
+    }
+}
+
+void RoomSnapshot::take(Screen& room)
+{
+    // Board: walls and floor come in long runs
+    size = room.size;
+    board.clear();
+    const CellIndex cells = size.cells();
+    for (CellIndex i = 0; i < cells; ) {
+        char c = room.board[i];
+        CellIndex run = 1;
+        while (i + run < cells && run < 255 && room.board[i + run] == c)
+            run++;
+        board += static_cast<char>(run);
+        board += c;
+        i += run;
+    }
+    board.shrink_to_fit();
+
+    legendRows = room.legendRows;
+    legend = room.legend;
+    sourceFile = room.sourceFile;
+
+    darkAreas.assign(room.darkAreas.begin(), room.darkAreas.end());
+    teleporters.assign(room.teleporters.begin(), room.teleporters.end());
+    copyOut(room.doors, doors);
+    copyOut(room.keys, keys);
+    copyOut(room.bombs, bombs);
+    copyOut(room.springs, springs);
+    copyOut(room.switches, switches);
+    copyOut(room.torches, torches);
+    copyOut(room.riddles, riddles);
+
+    obstacles.clear();
+    obstacles.reserve(room.obstacles.size());
+    for (const Obstacle& ob : room.obstacles)
+        obstacles.emplace_back(ob, nullptr);
+
+    taken = true;
+
+    // Objects are destroyed while their arena is still there, then the arena and its blocks go with
+    // the old Screen - the default one left behind has an arena without any block
+    room.clearRoom();
+    room = Screen();
+}
+
+void RoomSnapshot::restore(Screen& room)
+{
+    room.resize(size);
+    auto cell = room.board.begin();
+    for (size_t i = 0; i + 1 < board.size(); i += 2) {
+        int run = static_cast<unsigned char>(board[i]);
+        std::fill(cell, cell + run, board[i + 1]);
+        cell += run;
+    }
+
+    room.legendRows = legendRows;
+    room.legend = legend;
+    room.sourceFile = sourceFile;
+
+    // One arena block for everything, as when the room is read from its file (see RoomCompiler)
+    size_t maskBytes = 0;
+    for (const Obstacle& ob : obstacles)
+        maskBytes += ob.getMaskWords() * sizeof(std::uint64_t) + alignof(std::uint64_t);
+
+    room.arena->reserve(EntityStore<Door>::storageBytes(doors.size())
+        + EntityStore<Key>::storageBytes(keys.size())
+        + EntityStore<Bomb>::storageBytes(bombs.size())
+        + EntityStore<Switch>::storageBytes(switches.size())
+        + EntityStore<Torch>::storageBytes(torches.size())
+        + EntityStore<Riddle>::storageBytes(riddles.size())
+        + SlotMap<Spring>::storageBytes(springs.size())
+        + SlotMap<Obstacle>::storageBytes(obstacles.size()) + maskBytes
+        + darkAreas.size() * sizeof(DarkArea) + teleporters.size() * sizeof(TeleportPair) + 2 * alignof(Point));
+
+    room.darkAreas.assign(darkAreas.begin(), darkAreas.end());
+    room.teleporters.assign(teleporters.begin(), teleporters.end());
+
+    room.doors.reserve(doors.size());
+    room.keys.reserve(keys.size());
+    room.bombs.reserve(bombs.size());
+    room.springs.reserve(springs.size());
+    room.switches.reserve(switches.size());
+    room.torches.reserve(torches.size());
+    room.riddles.reserve(riddles.size());
+    room.obstacles.reserve(obstacles.size());
+
+    // Same insertion order as before, so iteration order (and with it the game) is unchanged
+    for (const Door& d : doors) room.addDoor(d);
+    for (const Key& k : keys) room.addKey(k);
+    for (const Bomb& b : bombs) room.addBomb(b);
+    for (const Spring& s : springs) room.addSpring(s);
+    for (const Switch& sw : switches) room.addSwitch(sw);
+    for (const Torch& t : torches) room.addTorch(t);
+    for (const Riddle& r : riddles) room.addRiddle(r);
+    for (const Obstacle& ob : obstacles) room.addObstacle(Obstacle(ob, room.arena.get()));
+
+    *this = RoomSnapshot();
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Screen.h"
+#include <string>
+#include <vector>
+
+// File: RoomSnapshot.h
+// Description:
+//   Compact copy of a room that is not resident (see RoomLoader::trim). take() moves the room's
+//   state out - the board run-length encoded, every entity by value in exactly sized vectors - and
+//   leaves a default Screen: no board, and a new arena that holds no memory until restore() sizes
+//   it (the old arena with its blocks is freed). restore() rebuilds the room into that Screen:
+//   the same cells and the same objects in the same order, so the game can't tell a restored room
+//   from one that stayed loaded.
+//   Nothing outside the room may hold a handle into it meanwhile (players' items, timers).
+
+class RoomSnapshot {
+private:
+    BoardSize size;
+    std::string board;                  // (run length, char) pairs, runs of up to 255 cells
+    int legendRows = 0;
+    LegendArea legend;
+    std::string sourceFile;
+
+    std::vector<DarkArea> darkAreas;
+    std::vector<TeleportPair> teleporters;
+    std::vector<Door> doors;
+    std::vector<Key> keys;
+    std::vector<Bomb> bombs;
+    std::vector<Spring> springs;
+    std::vector<Switch> switches;
+    std::vector<Torch> torches;
+    std::vector<Riddle> riddles;
+    std::vector<Obstacle> obstacles;    // bodies on the general heap (no arena)
+    bool taken = false;
+
+public:
+    bool empty() const { return !taken; }
+
+    void take(Screen& room);            // room is left empty
+    void restore(Screen& room);         // room must be a fresh Screen - the snapshot is emptied
+};
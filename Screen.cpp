@@ -1,14 +1,27 @@
 #include "Screen.h"
+#include "ComponentLabeler.h"
+#include "RoomCompiler.h"
+#include "MappedFile.h"
 #include <iostream>
+#include <algorithm>
 
 // Init Functions
 
 void Screen::setMap(const char* map[SCREEN_HEIGHT])
 {
 	// creating board for constant screens (menu, final etc..)
+	resize(BoardSize());
 	for (int r = 0; r < SCREEN_HEIGHT; r++)
 		for (int c = 0; c < SCREEN_WIDTH; c++)
-			board[c][r] = map[r][c];
+			board[size.cellOf(Point(c, r))] = map[r][c];
+}
+
+void Screen::resize(const BoardSize& newSize)
+{
+	size = newSize;
+	board.assign(size.cells(), ' ');
+	illuminated.assign(size.cells(), 0);
+	litCells.clear();
 }
 
 /*
@@ -18,176 +31,42 @@ void Screen::setMap(const char* map[SCREEN_HEIGHT])
  */
 bool Screen::loadScreenFromFile(const std::string& filename, std::string& errorMsg, std::string& warningMsg)
 {
-	std::ifstream file(filename);
-	if (!file.is_open())        // File could not be opened
+	MappedFile file;
+	if (!file.open(filename))        // File could not be opened
 	{
 		errorMsg = "Cannot open screen file: " + filename;
 		return false;
 	}
-	// Load the board layout (map area)
-	if (!loadMapFromFile(file, filename, errorMsg, warningMsg))
-	    return false;
-	// Create game objects according to board characters
-	if (!buildObjectsFromBoard(errorMsg))
-		return false;
-	// Read additional rules and data
-	if (!readDataFromFile(file, filename, errorMsg))
-		return false;
-
-	return true;
-}
+	TextScanner text = file.lines();
 
-bool Screen::loadMapFromFile(std::ifstream& file, const std::string& filename, std::string& errorMsg ,std::string& warningMsg)
-{
-	// Reads the screen map from file and fills the board array.
-	std::string line;
-	for (int y = 0; y < SCREEN_HEIGHT; y++)
-	{    // Expect exactly SCREEN_HEIGHT lines
-		if (!std::getline(file, line))
-		{
-			errorMsg = "Map from file: " + filename + "has too few lines";
-			return false;
-		}
-		// Each line must be wide enough
-		if ((int)line.length() < SCREEN_WIDTH)
-		{
-			errorMsg = "Map from file:" + filename + "\nLine " + std::to_string(y) + " is too short";
-			return false;
-		}
-
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{			
-			char c = line[x];
-
-			if (c == LEGEND)
-			{
-				// Legend anchor must appear exactly once
-				if (legend.exists)
-				{
-					errorMsg = "Map from file:" + filename + "\nMultiple legend anchors found";
-					return false;
-				}
-
-				setLegendAnchor(x, y);   
-				board[x][y] = ' ';     // legend cell is not part of the board
-			}
-			else if (isValidBoardChar(c))
-			{
-				// Valid game element
-				board[x][y] = c;
-			}
-			else
-			{   
-				// Unknown character: replace with space and warn once
-				board[x][y] = ' ';
-
-				if (warningMsg.empty())
-				{
-					warningMsg =
-						"Map from file: " + filename + "\n"
-						"Unknown characters were replaced with spaces";
-				}
-			}
-		}
-	}
-	// Legend must exist
-	if (!legend.exists)
-	{
-		errorMsg = "Map file: " + filename + "\n"
-			       "Legend is missing";	
+	// Load the board layout (map area) and create the game objects on it in one pass
+	RoomCompiler compiler(*this);
+	if (!compiler.compile(text, filename, errorMsg, warningMsg))
 		return false;
-	}
-
-	sourceFile = filename;
-	return true;
-}
-
-bool Screen::buildObjectsFromBoard(std::string& error)
-{
-	// Iterates over the board and creates game objects
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{
-			char c = board[x][y];
-			handleChar(c, x, y);
-		}
-	}
-	// Post-processing for multi-cell objects
-	if (!buildSpringsFromBoard(error))
+	// Read additional rules and data
+	if (!readDataFromFile(text, filename, errorMsg))
 		return false;
 
-
-	buildObstaclesFromBoard();
 	return true;
 }
 
-void Screen::handleChar(char c, int x, int y)
-{
-	// Creates a specific game object based on a board character.
-	
-	// ----- Door -----
-	if (c >= DOOR_MIN_CHAR && c <= DOOR_MAX_CHAR)
-	{
-		int dest = c - DIGIT_ZERO;
-		addDoor(Door(Point(x, y), dest));
-	}
-	// ----- Key -----
-	else if (c == BOARD_KEY)
-	{
-		addKey(Key(Point(x, y), -1));
-	}
-	// ----- Bomb -----
-	else if (c == BOARD_BOMB)
-	{
-		addBomb(Bomb(Point(x, y)));
-	}
-	// ----- Switch -----
-	else if (c == BOARD_SWITCH_OFF || c == BOARD_SWITCH_ON)
-	{
-		bool state = (c == BOARD_SWITCH_ON);
-		addSwitch(Switch(Point(x, y), -1, state));
-	}
-	// ----- Torch -----
-	else if (c == BOARD_TORCH)
-	{
-		addTorch(Torch(Point(x, y)));
-	}
-	else if (c == BOARD_RIDDLE)
-	{
-		addRiddle(Riddle(Point(x, y)));
-	}
-	else
-	{
-		// Empty or non-object cell
-		return;
-	}
-}
-
-bool Screen::readDataFromFile(std::ifstream& file, const std::string& filename, std::string& errorMsg)
+bool Screen::readDataFromFile(TextScanner& text, const std::string& filename, std::string& errorMsg)
 {   // Reads additional rule lines after the map section.
-	std::string line;
-	int lineNumber = SCREEN_HEIGHT; // Start reading from the end of the map
+	LineCursor line;
 
-	while (std::getline(file, line))
+	while (text.nextLine(line))
 	{
-		++lineNumber;
-
 		// Skip empty lines 
-		size_t firstChar = line.find_first_not_of(" \t\r\n");
-		if (firstChar == std::string::npos)
+		if (line.isBlank())
 			continue;
 
-
-		// Parse and 
-		// 
-		// rule
+		// Parse and apply the rule
 		std::string ruleError;
 		if (!parseDataLine(line, ruleError))
 		{
 			errorMsg =
 				"Screen file: " + filename +
-				"\nLine " + std::to_string(lineNumber) + ": " +
+				"\nLine " + std::to_string(line.line()) + ", column " + std::to_string(line.column()) + ": " +
 				ruleError;
 			return false;
 		}
@@ -196,20 +75,23 @@ bool Screen::readDataFromFile(std::ifstream& file, const std::string& filename,
 	return true;
 }
 
-bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
+bool Screen::parseDataLine(LineCursor& line, std::string& errorMsg)
 { // Parses a single rule line and applies it to the relevant object.
-	std::stringstream ss(line);
-	std::string type;
+	TextView type;
 
-	ss >> type;
+	line.readWord(type);
 	int x, y;
-	std::string tmp;    // if theres a problem check if its ok
+	TextView tmp;    // rule labels (DoorID, KEYS...) are skipped
 
 	if (type == "DARK")
 	{
 		int x1, x2, y1, y2;
 
-		ss >> x1 >> y1 >> x2 >> y2;
+		if (!(line.readInt(x1) && line.readInt(y1) && line.readInt(x2) && line.readInt(y2)))
+		{
+			errorMsg = "Invalid DARK rule format";
+			return false;
+		}
 
 		addDarkArea(Point(x1, y1), Point(x2, y2));
 	}
@@ -218,7 +100,8 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 		int doorID, keys, rule;
 
 	    // Expected structured format
-		if (!(ss >> x >> y >> tmp >> doorID >> tmp >> keys >> tmp >> rule))
+		if (!(line.readInt(x) && line.readInt(y) && line.readWord(tmp) && line.readInt(doorID) &&
+			line.readWord(tmp) && line.readInt(keys) && line.readWord(tmp) && line.readInt(rule)))
 		{
 			errorMsg = "Invalid Door rule format" ;
 			return false;
@@ -234,12 +117,25 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 		}
 
 		d->applyRules(doorID, keys, rule);
+
+		// A door may lead past room 9: "... TO <room>" anywhere after the rule overrides the board digit
+		while (line.readWord(tmp)) {
+			int dest;
+			if (tmp != "TO")
+				continue;
+			if (!line.readInt(dest))
+			{
+				errorMsg = "Invalid Door rule format";
+				return false;
+			}
+			d->setDestination(dest);
+		}
 	}
 	else if (type == "KEY")
 	{
 		int doorID;
  
-		if (!(ss >> x >> y >> tmp >> doorID))  	// Expected structured format
+		if (!(line.readInt(x) && line.readInt(y) && line.readWord(tmp) && line.readInt(doorID)))  	// Expected structured format
 		{
 			errorMsg = "Invalid Key rule format";
 			return false;
@@ -260,7 +156,7 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 	{
 		int doorID;
 
-		if (!(ss >> x >> y >> tmp >> doorID))    	// Expected structured format
+		if (!(line.readInt(x) && line.readInt(y) && line.readWord(tmp) && line.readInt(doorID)))    	// Expected structured format
 		{
 			errorMsg = "Invalid Switch rule format";
 			return false;
@@ -280,7 +176,7 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 	else if (type == "TELEPORT")
 	{
 		int x1, y1, x2, y2;
-		if (!(ss >> x1 >> y1 >> x2 >> y2))
+		if (!(line.readInt(x1) && line.readInt(y1) && line.readInt(x2) && line.readInt(y2)))
 		{
 			errorMsg = "Invalid TELEPORT format (expected: TELEPORT x1 y1 x2 y2)";
 			return false;
@@ -290,7 +186,7 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 
 	else    
 	{
-		errorMsg = "Unknown rule type: " + line;
+		errorMsg = "Unknown rule type: " + line.text().str();
 		return false;
 	}
 	return true;
@@ -299,14 +195,12 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 bool Screen::addTeleporterPair(Point p1, Point p2, std::string& errorMsg)
 {
 	// Validate points is within bounds
-	if (p1.getX() < 0 || p1.getX() >= SCREEN_WIDTH ||
-		p1.getY() < 0 || p1.getY() >= SCREEN_HEIGHT) {
+	if (!size.contains(p1)) {
 		errorMsg = "Teleporter out of bounds at (" +
 			std::to_string(p1.getX()) + "," + std::to_string(p1.getY()) + ")";
 		return false;
 	}
-	if (p2.getX() < 0 || p2.getX() >= SCREEN_WIDTH ||
-		p2.getY() < 0 || p2.getY() >= SCREEN_HEIGHT) {
+	if (!size.contains(p2)) {
 		errorMsg = "Teleporter out of bounds at (" +
 			std::to_string(p2.getX()) + "," + std::to_string(p2.getY()) + ")";
 		return false;
@@ -341,78 +235,6 @@ bool Screen::addTeleporterPair(Point p1, Point p2, std::string& errorMsg)
 	return true;
 }
 
-bool Screen::buildSpringsFromBoard(std::string& error)
-{
-	// Save links that are already part of a spring so we won't check them twice
-	// Also, if we find later links that are not in the cet means that they don't have a base
-	std::set<Point> usedSpringCells;
-
-	// Determines whether a spring cell (board[x][y] == BOARD_SPRING) is a base.
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{
-			if (!(isSpring({ x,y })))
-				continue;
-
-			// It is a spring!
-			Direction dir;
-			// Only build spring if this cell is a base
-			if (!isSpringBase(x, y, dir))
-				continue;
-
-			Point base(x, y);
-			// Count spring length
-			int size = 0;
-			Point p = base;
-
-			while (Point::checkLimits(p) &&
-				charAt(p) == BOARD_SPRING)
-			{
-				usedSpringCells.insert(p); // cell is assigned to existing spring, don't check it again
-				size++;
-				p = p.next(dir);
-			}
-			// Spring MUST be more than one char!
-			if (size < 2) {
-				error = "Spring at (" + std::to_string(x) +
-					"," + std::to_string(y) + ") must be at least 2 characters";
-				return false;
-			}
-
-			// Create spring object
-			addSpring(Spring(base, size, dir));
-		}
-	}
-	// this part was made with Claude help
-	// going through the screen and sees if there were links that weren't add to the set (because they had no base)
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{
-			if (isSpring({ x, y }) && usedSpringCells.find({ x, y }) == usedSpringCells.end())
-			{
-				bool hasAdjacentWall =
-					(y > 0 && isWall({ x, y - 1 })) ||
-					(y < SCREEN_HEIGHT - 1 && isWall({ x, y + 1 })) ||
-					(x > 0 && isWall({ x - 1, y })) ||
-					(x < SCREEN_WIDTH - 1 && isWall({ x + 1, y }));
-
-				if (hasAdjacentWall) {
-					error = "Spring at (" + std::to_string(x) +
-						"," + std::to_string(y) + ") must be at least 2 characters";
-				}
-				else {
-					error = "Spring character at (" + std::to_string(x) +
-						"," + std::to_string(y) + ") is not attached to a wall";
-				}
-				return false;
-			}
-		}
-	}
-	return true;
-}
-
 bool Screen::isSpringBase(int x, int y, Direction& dir) const
 {
 	// Spring MUST be more than one char!
@@ -425,7 +247,7 @@ bool Screen::isSpringBase(int x, int y, Direction& dir) const
 		}
 	}
 	// Wall below -> spring goes UP
-	if (y < SCREEN_HEIGHT - 1 && isWall({ x, y + 1 })) {
+	if (y < size.height - 1 && isWall({ x, y + 1 })) {
 		if (isSpring({ x,y - 1 })) {
 			dir = UP;
 			return true;
@@ -439,7 +261,7 @@ bool Screen::isSpringBase(int x, int y, Direction& dir) const
 		}
 	}
 	// Wall to the right -> spring goes LEFT
-	if (x < SCREEN_WIDTH - 1 && isWall({ x + 1, y })) {
+	if (x < size.width - 1 && isWall({ x + 1, y })) {
 		if (isSpring({ x - 1,y })) {
 			dir = LEFT;
 			return true;
@@ -448,108 +270,6 @@ bool Screen::isSpringBase(int x, int y, Direction& dir) const
 	return false;
 }
 
-void Screen::buildObstaclesFromBoard()  // *Developed with ChatGPT assistance*
-{	
-	// Scans the board and builds obstacle objects from connected obstacle cells.
-	bool visited[SCREEN_WIDTH][SCREEN_HEIGHT] = { false };   // Marks board cells that were already processed
-
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{
-			// Start DFS only from unvisited obstacle cells
-			if (charAt({ x, y }) == BOARD_OBSTACLE && !visited[x][y])
-			{
-				std::vector<Point> body;
-				collectObstacleDFS(x, y, visited, body);   // Collect all connected obstacle cells
-				addObstacle(Obstacle(body));     // Create a single obstacle from the collected cells
-			}
-		}
-	}
-}
-
-void Screen::collectObstacleDFS(int x, int y, bool visited[][SCREEN_HEIGHT], std::vector<Point>& body)
-{ // Recursively explores the four cardinal directions 
-
-	// Stop if out of board bounds
-	if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT)
-		return;
-
-	// Stop if this cell was already processed
-	if (visited[x][y])
-		return;
-
-	// Stop if this cell is not an obstacle
-	if (charAt({ x, y }) != BOARD_OBSTACLE)
-		return;
-
-	// Mark cell as visited and add it to the obstacle body
-	visited[x][y] = true;
-	body.push_back(Point(x, y));
-
-	// Explore neighboring cells
-	collectObstacleDFS(x + 1, y, visited, body);
-	collectObstacleDFS(x - 1, y, visited, body);
-	collectObstacleDFS(x, y + 1, visited, body);
-	collectObstacleDFS(x, y - 1, visited, body);
-}
-
-bool Screen::isValidBoardChar(char c) const
-{	// Checks whether a character is allowed in the screen map.
-	if (c >= DOOR_MIN_CHAR && c <= DOOR_MAX_CHAR) 
-		return true;
-	switch (c)
-	{
-	case ' ':
-	case BOARD_WALL:
-	case WALL_HORIZ:
-	case WALL_VERT:
-	case BOARD_KEY:
-	case BOARD_TORCH:
-	case BOARD_BOMB:
-	case BOARD_SWITCH_ON:
-	case BOARD_SWITCH_OFF:
-	case BOARD_RIDDLE:
-	case BOARD_OBSTACLE:
-	case BOARD_SPRING:
-	case BOARD_TELEPORT:
-	case LEGEND:
-		return true;
-	default: // c isn't one of the other cases
-		return false;
-	}
-}
-
-bool Screen::validateLegendPlacement(std::string& errorMsg) const
-{   // Validates that the legend does not overlap forbidden board elements.
-	if (!legend.exists)
-		return true;
-
-	for (int y = legend.topLeft.getY(); y <= legend.bottomRight.getY(); ++y)
-	{
-		for (int x = legend.topLeft.getX(); x <= legend.bottomRight.getX(); ++x)
-		{
-			char c = board[x][y];
-
-			// Legend may overlap only empty cells or outer walls
-			if (c != ' ' && c != 'W')
-			{
-				errorMsg = "Invalid LEGEND placement: overlaps forbidden object '";
-				errorMsg += c;
-				errorMsg += "' at position (";
-				errorMsg += std::to_string(x);
-				errorMsg += ",";
-				errorMsg += std::to_string(y);
-				errorMsg += ").";
-
-				return false;
-			}
-		}
-	}
-
-	return true;
-}
-
 bool Screen::validateDoors(int numRooms, std::string& errorMsg) const
 {
 	for (const Door& d : doors)
@@ -568,23 +288,29 @@ bool Screen::validateDoors(int numRooms, std::string& errorMsg) const
 	return true;
 }
 
+std::vector<int> Screen::getDestinations() const
+{
+	std::vector<int> dests;
+	for (const Door& d : doors)
+		dests.push_back(d.getDestination());
+	return dests;
+}
+
 // Objects related Functions
 void Screen::addDarkArea(const Point& topLeft, const Point& bottomRight)
 {
 	darkAreas.emplace_back(DarkArea{ topLeft, bottomRight });
 }
 
-void Screen::addObstacle(const Obstacle& ob)
+void Screen::addObstacle(Obstacle&& ob)
 {
-	obstacles.emplace_back(ob);
+	obstacles.insert(std::move(ob));
 }
 
 void Screen::clearRoom()
 {
 	// clear board
-	for (int x = 0; x < SCREEN_WIDTH; ++x)
-		for (int y = 0; y < SCREEN_HEIGHT; ++y)
-			board[x][y] = ' ';
+	std::fill(board.begin(), board.end(), ' ');
 
 	// clear illumination
 	clearIllumination();
@@ -597,136 +323,137 @@ void Screen::clearRoom()
 void Screen::resetObjects()
 {
 	legend = LegendArea{};
-	darkAreas.clear();
-
-	doors.clear();
-	keys.clear();
-	bombs.clear();
-	springs.clear();
-	switches.clear();
-	torches.clear();
-	riddles.clear();
-	obstacles.clear();
-	teleporters.clear();
+
+	// drop every container's storage, then the whole arena at once
+	ArenaVector<DarkArea>(darkAreas.get_allocator()).swap(darkAreas);
+	ArenaVector<TeleportPair>(teleporters.get_allocator()).swap(teleporters);
+
+	doors.release();
+	keys.release();
+	bombs.release();
+	springs.release();
+	switches.release();
+	torches.release();
+	riddles.release();
+	obstacles.release();
+
+	arena->release();
+}
+
+// Used to keep the state of a room in memory (see GameSave.h). Every object keeps its slot,
+// so the handles players and timers hold stay valid for the copy
+void Screen::copyFrom(const Screen& other)
+{
+	resetObjects();
+
+	size = other.size;
+	board = other.board;
+	illuminated = other.illuminated;
+	litCells = other.litCells;
+	legend = other.legend;
+	legendRows = other.legendRows;
+	sourceFile = other.sourceFile;
+
+	darkAreas.assign(other.darkAreas.begin(), other.darkAreas.end());
+	teleporters.assign(other.teleporters.begin(), other.teleporters.end());
+	doors.copyFrom(other.doors);
+	keys.copyFrom(other.keys);
+	bombs.copyFrom(other.bombs);
+	springs.copyFrom(other.springs);
+	switches.copyFrom(other.switches);
+	torches.copyFrom(other.torches);
+	riddles.copyFrom(other.riddles);
+	obstacles.copyFrom(other.obstacles, [this](const Obstacle& ob) { return Obstacle(ob, arena.get()); });
 }
 
 // Display Functions
 
-void Screen::drawChar(const Point& p,const char c)
+void Screen::drawChar(const Point& p,const char c, const Viewport& view)
 {
 	// Draws a character on screen and updates the board buffer.
-    board[p.getX()][p.getY()] = c;
-	if (isVisible(p))
-	{
-		Utils::gotoxy(p.getX(), p.getY());
-		std::cout << c;
-	}
+    board[size.cellOf(p)] = c;
+	if (isVisibleInView(p))
+		view.put(p, c);
 }
 
 void Screen::erase(const Point& p)
 {
-	if (Point::checkLimits(p)) {
-		board[p.getX()][p.getY()] = ' ';
+	if (size.contains(p)) {
+		board[size.cellOf(p)] = ' ';
 	}
 }
 
-// Draws the full screen: map base + all active items.
-void Screen::drawScreen() 
+// Draws the room's window on the terminal: map base + all active items.
+void Screen::drawScreen(const Viewport& view)
 {
-	drawBase();
-	drawItems();
+	drawBase(view);
+	drawItems(view);
 }
 
-// Prints the entire board buffer to the console.
-void Screen::drawBase()                       
+// Prints the board buffer inside the view, a row at a time (a standard room on the whole
+// terminal is shown whole). The part of the window a smaller room doesn't cover is blanked.
+void Screen::drawBase(const Viewport& view)
 {
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
-	{
-		Utils::gotoxy(0, y);
+	const Point& origin = view.getOrigin();
+	int rows = std::min(view.getHeight(), size.height - origin.getY());
+	int cols = std::min(view.getWidth(), size.width - origin.getX());
+	std::string line(view.getWidth(), ' ');
+	clipDarkAreas(view);
 
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
+	for (int y = 0; y < view.getHeight(); ++y)
+	{
+		std::fill(line.begin(), line.end(), ' ');
+		if (y < rows)
 		{
-			Point p(x, y);
+			const char* row = board.data() + size.cellOf(Point(origin.getX(), origin.getY() + y));
 
-			if (isVisible(p) || board[x][y] == BOARD_WALL)
-				std::cout << board[x][y];
-			else
-				std::cout << DARK_CHAR;   
+			for (int x = 0; x < cols; ++x)
+			{
+				Point p(origin.getX() + x, origin.getY() + y);
+				line[x] = (row[x] == BOARD_WALL || isVisibleInView(p)) ? row[x] : DARK_CHAR;
+			}
 		}
+		view.text(Point(0, y), line);
 	}
 }
 
-// Draws all visible objects onto the screen.
-void Screen::drawItems()
+// Draws all visible objects inside the view onto the screen. Objects outside the view are skipped
+// before anything is drawn - springs and obstacles on their bounding box.
+void Screen::drawItems(const Viewport& view)
 {
+	clipDarkAreas(view);
 
-	for (const auto& d : doors) {
-		Point p = d.getPos();
-		char fig = d.getFigure();
-		drawChar(p, fig);
-	}
-
-	for (const auto& sw : switches) {
-		Point p = sw.getPos();
-		char fig = sw.getFigure();
-		drawChar(p, fig);
-	}
-
-	for (const auto& k : keys) {
-		if (k.isActive())
-		{
-			Point p = k.getPos();
-			char fig = k.getFigure();
-			drawChar(p, fig);
-		}
-	}
-
-	for (const auto& b : bombs) {
-		if (b.isActive())
-		{
-			Point p = b.getPos();
-			char fig = b.getFigure();
-			drawChar(p, fig);
-		}
-	}
-
-	for (const auto& r : riddles) {
-		if (!r.isSolved())
-		{
-			Point p = r.getPos();
-			char fig = r.getFigure();
-			drawChar(p, fig);
-		}
-	}
-
-	for (const auto& t : torches) {
-		if (t.isActive())
-		{
-			Point p = t.getPos();
-			char fig = t.getFigure();
-			drawChar(p, fig);
-		}
-	}
+	// single-cell objects - only the packed position / figure columns are read
+	auto draw = [&](const Point& p, char fig) { if (view.contains(p)) drawChar(p, fig, view); };
+	doors.forEachShown(draw);
+	switches.forEachShown(draw);
+	keys.forEachShown(draw);
+	bombs.forEachShown(draw);
+	riddles.forEachShown(draw);
+	torches.forEachShown(draw);
 
 	for (const auto& sp : springs) 
 	{
+		if (sp.getCurrSize() == 0)
+			continue;
+
+		Point base = sp.getLinkPos(0);
+		Point tip = sp.getLinkPos(sp.getCurrSize() - 1);
+		if (!view.overlaps(Point(std::min(base.getX(), tip.getX()), std::min(base.getY(), tip.getY())),
+			Point(std::max(base.getX(), tip.getX()), std::max(base.getY(), tip.getY()))))
+			continue;
+
 		for (int k = 0; k < sp.getCurrSize(); k++)
-		{
-			Point p = sp.getLinkPos(k);
-			char fig = sp.getFigure();
-			drawChar(p, fig);
-		}
+			draw(sp.getLinkPos(k), sp.getFigure());
 	}
 
 	for (const Obstacle& ob : obstacles)
 	{
-		const std::vector<Point>& body = ob.getBody();
-		char fig = ob.getFigure();
+		if (!view.overlaps(ob.getTopLeft(), ob.getBottomRight()))
+			continue;
 
-		for (const Point& p : body)
-		{
-			drawChar(p, fig);
-		}
+		char fig = ob.getFigure();
+		ob.forEachCell([&](const Point& p) { draw(p, fig); });
 	}
 
 }
@@ -735,12 +462,8 @@ void Screen::drawItems()
 
 bool Screen::isCellFree(const Point& pos) const
 {
-	int x = pos.getX();
-	int y = pos.getY();
-
-	// checking pos isn't out of screen bounds
-	if (x < 0 || x >= SCREEN_WIDTH ||
-		y < 0 || y >= SCREEN_HEIGHT)
+	// checking pos isn't out of the room's bounds
+	if (!size.contains(pos))
 	{
 		return false;
 	}
@@ -850,52 +573,69 @@ Point Screen::getTeleportDest(const Point& p) const { // returns portal dest
 // Adding a collected item to player's inventory
 void Screen::collectKey(Player& player, const Point& p)
 {
-	for (int i = 0; i < keys.size(); i++) {
-		if (keys[i].isActive() && keys[i].getPos().isAt(p)) {
+	int i = keys.indexAt(p, true);   // only a key that is still on the board
+	if (i < 0) return;
 
-			player.collectItem(KEY, i);
-			keys[i].deactivate();
-			erase(p);
-			break;
-		}
-	}
+	player.collectItem(KEY, keys.handleAt(i));
+	keys[i].deactivate();
+	keys.refreshAt(i);
+	erase(p);
 }
 
 void Screen::collectBomb(Player& player, const Point& p)
 {
-	for (int i = 0; i < bombs.size(); i++) {
-		if (bombs[i].isActive() && !bombs[i].isTicking() && bombs[i].getPos().isAt(p)) {
+	int i = bombs.indexAt(p, true);
+	if (i < 0 || bombs[i].isTicking()) return;     // an armed bomb can't be picked up
 
-			player.collectItem(BOMB, i);
-			bombs[i].deactivate();
-			erase(p);
-			break;
-		}
+	player.collectItem(BOMB, bombs.handleAt(i));
+	bombs[i].deactivate();
+	bombs.refreshAt(i);
+	erase(p);
+}
+
+void Screen::refreshStored(ItemType type, const EntityHandle& h)
+{
+	// The board holds the item right away - drawing skips it while it is outside the view
+	auto place = [this](const auto* item) { if (item && item->isShown()) setChar(item->getPos(), item->getFigure()); };
+
+	switch (type) {
+	case KEY:   keys.refresh(h); place(keys.get(h)); break;
+	case BOMB:  bombs.refresh(h); place(bombs.get(h)); break;
+	case TORCH: torches.refresh(h); place(torches.get(h)); break;
+	default: break;
 	}
 }
 
+// Flips the switch at p, nullptr if there is none
+Switch* Screen::toggleSwitchAt(const Point& p)
+{
+	int i = switches.indexAt(p);
+	if (i < 0) return nullptr;
+
+	switches[i].toggle();
+	switches.refreshAt(i);     // figure depends on the state
+	return &switches[i];
+}
+
 void Screen::collectTorch(Player& player, const Point& p)
 {
-	for (int i = 0; i < torches.size(); i++)
-	{
-		if (torches[i].isActive() && torches[i].getPos().isAt(p))
-		{
-			player.collectItem(TORCH, i);
-			torches[i].deactivate();
-			erase(p);
-			break;
-		}
-	}
+	int i = torches.indexAt(p, true);
+	if (i < 0) return;
+
+	player.collectItem(TORCH, torches.handleAt(i));
+	torches[i].deactivate();
+	torches.refreshAt(i);
+	erase(p);
 }
 
 void Screen::pushObstacle(Obstacle& ob, Direction dir)
-{    // Clears obstacle from board and moves it atomically
+{    // Moves the obstacle one cell - only its edges change on the board
+
+	// cells nothing of the body moves into are cleared
+	ob.forEachTrailingCell(dir, [this](const Point& cell) { erase(cell); });
+	// cells the body moves onto for the first time
+	ob.forEachLeadingCell(dir, [&](const Point& cell) { setChar(cell.next(dir), BOARD_OBSTACLE); });
 
-	for (const Point& cell : ob.getBody())   	// Remove all current obstacle cells from the board
-	{
-		erase(cell);
-	}
-	// Move the entire obstacle body
 	ob.move(dir);
 }
 
@@ -907,7 +647,7 @@ void Screen::setLegendAnchor(int x, int y)
 	legend.topLeft = Point(x, y);
 	legend.bottomRight = Point(
 		x + LEGEND_WIDTH - 1,
-		y + LEGEND_HEIGHT - 1
+		y + legendRows - 1
 	);
 	legend.exists = true;
 }
@@ -932,7 +672,7 @@ void Screen::clearLegendAreaFromBoard()
 	{
 		for (int x = legend.topLeft.getX(); x <= legend.bottomRight.getX(); ++x)
 		{
-			board[x][y] = ' ';
+			board[size.cellOf(Point(x, y))] = ' ';
 		}
 	}
 }
@@ -952,6 +692,33 @@ bool Screen::isVisible(const Point& p) const
 	return false;
 }
 
+// Only the dark areas kept by clipDarkAreas() are tested - a frame doesn't scan every area of the room per cell
+void Screen::clipDarkAreas(const Viewport& view)
+{
+	viewDarkAreas.clear();
+	for (const DarkArea& area : darkAreas)
+	{
+		if (view.overlaps(area.topLeft, area.bottomRight))
+			viewDarkAreas.push_back(area);
+	}
+}
+
+bool Screen::isVisibleInView(const Point& p) const
+{
+	for (const DarkArea& area : viewDarkAreas)
+	{
+		if (p.getX() >= area.topLeft.getX() &&
+			p.getX() <= area.bottomRight.getX() &&
+			p.getY() >= area.topLeft.getY() &&
+			p.getY() <= area.bottomRight.getY())
+		{
+			return isIlluminated(p);
+		}
+	}
+
+	return true;
+}
+
 bool Screen::isInDarkArea(const Point& p) const
 {
 	// Checks whether the given position lies within any predefined dark area
@@ -972,7 +739,7 @@ bool Screen::isInDarkArea(const Point& p) const
 bool Screen::isIlluminated(const Point& p) const  // MAYBE MOVE TO HEADER AS INLINE
 {
 	// Returns whether the given cell is currently marked as illuminated
-	return illuminated[p.getX()][p.getY()];
+	return illuminated[size.cellOf(p)];
 }
 
 void Screen::illuminateMap(const Point& center)
@@ -992,11 +759,14 @@ void Screen::illuminateMap(const Point& center)
 			int y = cy + dy;
 
 			// Ignore out-of-bounds cells
-			if (!Point::checkLimits(Point(x, y)))
+			if (!size.contains(Point(x, y)))
 				continue;
 
 			// Always illuminate the center cell
-			illuminated[x][y] = true;
+			CellIndex cell = size.cellOf(Point(x, y));
+			if (!illuminated[cell])
+				litCells.push_back(cell);
+			illuminated[cell] = 1;
 		}
 	}
 }
@@ -1004,13 +774,9 @@ void Screen::illuminateMap(const Point& center)
 void Screen::clearIllumination()
 {
 	// Clears all illumination marks before recalculating lighting.
-	for (int y = 0; y < SCREEN_HEIGHT; y++)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; x++)
-		{
-			illuminated[x][y] = false;
-		}
-	}
+	for (CellIndex cell : litCells)
+		illuminated[cell] = 0;
+	litCells.clear();
 }
 
 
@@ -1047,7 +813,7 @@ bool Screen::removeSpringAt(const Point& p) {
 				for (int i = 0; i < it->getCurrSize(); i++) { //fully delete spring so we won't have "flying" links
 					erase(it->getLinkPos(i)); //erase from screen
 				}
-				springs.erase(it); //erase from vector
+				springs.erase(it); //erase from list
 				return true;
 			}
 
@@ -1071,24 +837,41 @@ void Screen::removeObstacleAt(const Point& p)
 	for (size_t i = 0; i < obstacles.size(); i++)
 	{
 		Obstacle& ob = obstacles[i];
-		auto& body = ob.getBody();
 
-		for (size_t j = 0; j < body.size(); j++)
+		if (ob.removeCell(p))
 		{
-			if (body[j] == p)
-			{
-				body.erase(body.begin() + j);
-
-				if (body.empty())
-				{
-					obstacles.erase(obstacles.begin() + i);
-				}
-				return;
-			}
+			if (ob.isEmpty())
+				obstacles.eraseAt(i);
+			else
+				splitObstacle(i);
+			return;
 		}
 	}
 }
 
+// After a cell was removed the rest of the obstacle may fall apart -
+// the first piece stays in place of the obstacle, every other piece becomes an obstacle of its own
+void Screen::splitObstacle(size_t index)
+{
+	const Obstacle& ob = obstacles[index];
+	int total = ob.getSize();
+	bool first = true;
+	ComponentLabeler labeler;
+
+	// the pieces are emitted only after the whole box was scanned, so ob isn't needed by then
+	labeler.run(ob.getTopLeft(), ob.getBottomRight(),
+		[&ob](const Point& p) { return ob.isObBody(p); },
+		[&](const Point* cells, int count) {
+			if (first) {
+				first = false;
+				if (count == total) return;      // still in one piece
+				obstacles[index] = Obstacle(cells, count, arena.get());
+			}
+			else
+				addObstacle(Obstacle(cells, count, arena.get()));
+		});
+}
+
 bool Screen::removeTeleporterAt(const Point& p)
 {
 	bool removed = false;
@@ -1098,8 +881,8 @@ bool Screen::removeTeleporterAt(const Point& p)
 		if (teleporters[i].p1 == p || teleporters[i].p2 == p)
 		{
 			// screen
-			drawChar(teleporters[i].p1, ' ');
-			drawChar(teleporters[i].p2, ' ');
+			setChar(teleporters[i].p1, ' ');
+			setChar(teleporters[i].p2, ' ');
 			// logic
 			teleporters.erase(teleporters.begin() + i);
 			removed = true;
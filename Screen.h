@@ -12,10 +12,11 @@
 #include "Riddle.h"
 #include "Maps.h"
 #include "Templates.h"
-#include <fstream>
+#include "TextScanner.h"
+#include "Viewport.h"
 #include <string>
 #include <vector>
-#include <set>
+#include <memory>
 #include <stdexcept>
 
 struct LegendArea{
@@ -36,69 +37,80 @@ struct TeleportPair {
 
 class Screen {
 private:
-	char board[SCREEN_WIDTH][SCREEN_HEIGHT]; // 2D buffer storing the room's characters 
+	// Backs all entity storage below - must be declared first (see RoomArena.h)
+	std::unique_ptr<RoomArena> arena = std::unique_ptr<RoomArena>(new RoomArena());
 
-	std::vector<DarkArea> darkAreas;       // Stores all predefined dark regions in the room.
+	BoardSize size;           // standard rooms are as large as the terminal, larger ones are scrolled
+	std::vector<char> board;  // buffer storing the room's characters, indexed by CellIndex (empty until loaded)
+
+	ArenaVector<DarkArea> darkAreas{ ArenaAllocator<DarkArea>(arena.get()) };   // Stores all predefined dark regions in the room.
 	LegendArea legend;
+	int legendRows = legendHeight(DEFAULT_PLAYERS);   // legend grows with the number of players
 
-	bool illuminated[SCREEN_WIDTH][SCREEN_HEIGHT];      // Marks which cells are currently illuminated by torches.
-	bool validationMask[SCREEN_HEIGHT][SCREEN_WIDTH];  	// Used for object placement validation during screen loading
+	std::vector<unsigned char> illuminated;   // Marks which cells are currently illuminated by torches.
+	std::vector<CellIndex> litCells;          // the cells marked - clearing costs the lit area, not the room
+	std::vector<DarkArea> viewDarkAreas;      // the dark areas overlapping the view being drawn
 	std::string sourceFile = "";
 
-	std::vector<Door> doors;
-	std::vector<Key> keys;
-	std::vector<Bomb> bombs;
-	std::vector<Spring> springs;
-	std::vector<Switch> switches;
-	std::vector<Torch> torches;
-	std::vector<Riddle> riddles;
-	std::vector<Obstacle> obstacles;
-	std::vector<TeleportPair> teleporters;
+	// Room entities - players can hold stable handles to them (see SlotMap.h).
+	// Single-cell objects keep position / figure / shown in packed columns (see EntityStore.h)
+	EntityStore<Door> doors{ arena.get() };
+	EntityStore<Key> keys{ arena.get() };
+	EntityStore<Bomb> bombs{ arena.get() };
+	SlotMap<Spring> springs{ arena.get() };
+	EntityStore<Switch> switches{ arena.get() };
+	EntityStore<Torch> torches{ arena.get() };
+	EntityStore<Riddle> riddles{ arena.get() };
+	SlotMap<Obstacle> obstacles{ arena.get() };
+	ArenaVector<TeleportPair> teleporters{ ArenaAllocator<TeleportPair>(arena.get()) };
+
+	friend class RoomCompiler;  // builds the board and the objects while a screen file is read
+	friend class RoomSnapshot;  // keeps the room while it is not resident
+
+	void resize(const BoardSize& newSize);     // empty board of that size
+	void clipDarkAreas(const Viewport& view);  // fills viewDarkAreas
+	bool isVisibleInView(const Point& p) const;   // isVisible() for a cell of the view, after clipDarkAreas()
 
 public:
 	Screen() = default;                 // default ctor 
 
 	void setMap(const char* map[SCREEN_HEIGHT]);
 	bool loadScreenFromFile(const std::string& filename, std::string& errorMsg, std::string& warningMsg);
-	bool loadMapFromFile(std::ifstream& file, const std::string& filename, std::string& errorMsg, std::string& warningMsg);
-	bool buildObjectsFromBoard(std::string& errorMsg);
-	void handleChar(char c, int x, int y);
-	bool readDataFromFile(std::ifstream& file, const std::string& filename, std::string& errorMsg);
-	bool parseDataLine(const std::string& line, std::string& error);
+	bool readDataFromFile(TextScanner& text, const std::string& filename, std::string& errorMsg);
+	bool parseDataLine(LineCursor& line, std::string& error);
 	bool addTeleporterPair(Point p1, Point p2, std::string& errorMsg);
 
 	// Helpers 
-	bool buildSpringsFromBoard(std::string& error);
 	bool isSpringBase(int x, int y, Direction& dir) const;
-	void buildObstaclesFromBoard();
-	void collectObstacleDFS(int x, int y, bool visited[][SCREEN_HEIGHT], std::vector<Point>& body);
-	bool isValidBoardChar(char c) const;
-	bool validateLegendPlacement(std::string& errorMsg) const;
 	bool validateDoors(int numRooms, std::string& errorMsg) const;
+	std::vector<int> getDestinations() const;     // rooms the doors lead to
 	const std::string& getSourceFile() const { return sourceFile; }
+	const BoardSize& getSize() const { return size; }
 
 	void clearRoom();
 	void resetObjects();
+	void copyFrom(const Screen& other);   // exact copy - handles into other find the same objects here
 
 	void addDarkArea(const Point& topLeft, const Point& bottomRight);
-	void addDoor(const Door& d) { doors.push_back(d); }
-	void addKey(const Key& k) { keys.push_back(k); }
-	void addBomb(const Bomb& b) { bombs.push_back(b); }
-	void addSpring(const Spring& s) { springs.push_back(s); }
-	void addSwitch(const Switch& sw) { switches.push_back(sw); }
-	void addTorch(const Torch& t) { torches.push_back(t); }
-	void addRiddle(const Riddle& r) { riddles.push_back(r); }
-	void addObstacle(const Obstacle& ob);
+	void addDoor(const Door& d) { doors.insert(d); }
+	void addKey(const Key& k) { keys.insert(k); }
+	void addBomb(const Bomb& b) { bombs.insert(b); }
+	void addSpring(const Spring& s) { springs.insert(s); }
+	void addSwitch(const Switch& sw) { switches.insert(sw); }
+	void addTorch(const Torch& t) { torches.insert(t); }
+	void addRiddle(const Riddle& r) { riddles.insert(r); }
+	void addObstacle(Obstacle&& ob);
 
 	// Display Functions
-	void drawChar(const Point& p, char c); // draws specific char at point in screen
+	void drawChar(const Point& p, char c, const Viewport& view); // draws specific char at point in screen
+	void setChar(const Point& p, char c) { board[size.cellOf(p)] = c; }  // board only - shown on next render
 	void erase(const Point& p);    // erases specific char from point in screen
 	bool isCellFree(const Point& pos) const;
-	void drawScreen();
-	void drawBase();
-	void drawItems();
+	void drawScreen(const Viewport& view);
+	void drawBase(const Viewport& view = Viewport());
+	void drawItems(const Viewport& view);
 	char charAt(const Point& p) const {   // returns the character stored at the given screen position.
-		return board[p.getX()][p.getY()];
+		return size.contains(p) ? board[size.cellOf(p)] : BOARD_WALL;   // outside the room - a wall
 	}
 	bool isWall(const Point& p) const;
 	bool isItem(const Point& p) const;
@@ -109,11 +121,11 @@ public:
 
 	// Get Functions
 
-	std::vector<Bomb>& getBombs() { return bombs; }
-	const std::vector<Bomb>& getBomb() const { return bombs; }
+	EntityStore<Bomb>& getBombs() { return bombs; }
+	const EntityStore<Bomb>& getBomb() const { return bombs; }
 
-	const std::vector<Switch>& getSwitches() const { return switches; }
-	const std::vector<Spring>& getSprings() const { return springs; }
+	const EntityStore<Switch>& getSwitches() const { return switches; }
+	const SlotMap<Spring>& getSprings() const { return springs; }
 
 	// Get Objects Functions 
 	Door* getDoorAt(const Point& p) { return getItemAt(doors, p); }
@@ -133,15 +145,19 @@ public:
 	void collectBomb(Player& player, const Point& p);
 	void collectTorch(Player& player, const Point& p);
 
-	// helps get the key\bomb\torch object from player's inventory
-	Key& getStoredKey(int index) { return keys[index]; }
-	Bomb& getStoredBomb(int index) { return bombs[index]; }
-	Torch& getStoredTorch(int index) { return torches[index]; }
+	// helps get the key\bomb\torch object from player's inventory (nullptr if it no longer exists)
+	Key* getStoredKey(const EntityHandle& h) { return keys.get(h); }
+	Bomb* getStoredBomb(const EntityHandle& h) { return bombs.get(h); }
+	Torch* getStoredTorch(const EntityHandle& h) { return torches.get(h); }
+	void refreshStored(ItemType type, const EntityHandle& h);   // after a stored item was placed back - puts it on the board
+
+	Switch* toggleSwitchAt(const Point& p);
 
 	void pushObstacle(Obstacle& ob, Direction dir);
 
 	// Legend helpers
 	void setLegendAnchor(int x, int y);
+	void setLegendRows(int rows) { legendRows = rows; }
 	const LegendArea& getLegend() const { return legend; }
 	bool isLegendCell(const Point& p) const;
 	void clearLegendAreaFromBoard();
@@ -158,6 +174,7 @@ public:
 	bool removeObjectsAt(const Point& p);
 	bool removeSpringAt(const Point& p);
 	void removeObstacleAt(const Point& p);
+	void splitObstacle(size_t index);
 	bool removeTeleporterAt(const Point& p);
 	void removeRiddleAt(const Point& p) { removeItemAt(riddles, p); }
 	bool removeBombAt(const Point& p) { return removeItemAt(bombs, p); }
@@ -0,0 +1,69 @@
+#include "ScreenId.h"
+#include "MappedFile.h"
+#include "Utils.h"
+#include <cstdio>
+
+namespace {
+    constexpr size_t HASH_DIGITS = 16;
+
+    bool parseHex(const std::string& text, std::uint64_t& value) {
+        if (text.length() != HASH_DIGITS)
+            return false;
+        value = 0;
+        for (char c : text) {
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+            if (digit < 0)
+                return false;
+            value = (value << 4) | static_cast<std::uint64_t>(digit);
+        }
+        return true;
+    }
+}
+
+std::string ScreenId::line() const
+{
+    char hex[HASH_DIGITS + 1];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(hex) + ' ' + file;
+}
+
+ScreenId ScreenId::fromLine(const std::string& line)
+{
+    ScreenId id;
+    size_t space = line.find(' ');
+    if (space != std::string::npos && parseHex(line.substr(0, space), id.hash)) {
+        id.hashed = true;
+        id.file = line.substr(space + 1);
+    }
+    else
+        id.file = line;                 // an older header - the name alone
+    return id;
+}
+
+bool ScreenId::hashFile(const std::string& file, std::uint64_t& hash)
+{
+    MappedFile screen;
+    if (!screen.open(file))
+        return false;
+    hash = Utils::hashBytes(screen.getData(), screen.getSize());
+    return true;
+}
+
+bool sameRooms(const std::vector<ScreenId>& a, const std::vector<ScreenId>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!a[i].sameRoom(b[i]))
+            return false;
+    }
+    return true;
+}
+
+std::uint64_t worldHash(const std::vector<ScreenId>& rooms)
+{
+    std::uint64_t hash = Utils::HASH_SEED;
+    for (const ScreenId& room : rooms)
+        hash = Utils::hashBytes(&room.hash, sizeof(room.hash), hash);
+    return hash;
+}
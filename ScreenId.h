@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// File: ScreenId.h
+// Description:
+//   How a recording names the rooms it was played in: by the hash of each screen file's content,
+//   taken once when the game loads its files. Replays compare the hashes, so an edited room with the
+//   same name is told apart and a renamed room with the same content is still the same room.
+//   The file name goes along for people to read (and for the text files of older recordings, whose
+//   lines have no hash - those rooms are still matched by name).
+//   In the "# screens" header of a text file a room is one line: "<16 hex digits> <file name>".
+
+struct ScreenId {
+    std::string file;
+    std::uint64_t hash = 0;
+    bool hashed = false;                // false - an older header only named the file
+
+    ScreenId() = default;
+    ScreenId(std::string _file, std::uint64_t _hash) : file(std::move(_file)), hash(_hash), hashed(true) {}
+
+    bool sameRoom(const ScreenId& other) const {
+        return (hashed && other.hashed) ? hash == other.hash : file == other.file;
+    }
+
+    std::string line() const;           // for a text header
+    static ScreenId fromLine(const std::string& line);
+
+    // FNV-1a over the file's bytes - false if the file can't be read
+    static bool hashFile(const std::string& file, std::uint64_t& hash);
+};
+
+bool sameRooms(const std::vector<ScreenId>& a, const std::vector<ScreenId>& b);
+std::uint64_t worldHash(const std::vector<ScreenId>& rooms);   // one value for the rooms, in order
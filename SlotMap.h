@@ -0,0 +1,168 @@
+#pragma once
+#include "RoomArena.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Identifies an entity stored in a SlotMap. The generation tells a live entity apart from
+// one that was removed and whose slot was reused, so a stale handle simply finds nothing.
+struct EntityHandle {
+    int slot = -1;
+    unsigned gen = 0;
+
+    bool isSet() const { return slot >= 0; }
+    bool operator==(const EntityHandle& other) const { return slot == other.slot && gen == other.gen; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Room entities (doors, keys, bombs...) live here instead of in a plain vector.
+// The objects stay packed for iteration, removal is still swap & pop, but every object
+// also owns a slot that follows it around - handles given out by insert() stay valid
+// until that object is removed, no matter what happens to the others.
+// All storage comes from the room's arena when one is given.
+template <typename T>
+class SlotMap {
+private:
+    struct Slot {
+        int dense = -1;         // index of the object in items, -1 if the slot is free
+        unsigned gen = 0;       // bumped every time the slot is freed
+    };
+
+    ArenaVector<T> items;       // live objects, packed
+    ArenaVector<int> owners;    // slot of every object in items
+    ArenaVector<Slot> slots;
+    ArenaVector<int> freeSlots;
+    unsigned firstGen = 0;      // generation of newly created slots - raised by release()
+
+    int takeSlot() {
+        int s;
+        if (!freeSlots.empty()) {
+            s = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else {
+            s = static_cast<int>(slots.size());
+            slots.emplace_back();
+            slots[s].gen = firstGen;
+        }
+        slots[s].dense = static_cast<int>(items.size());
+        owners.push_back(s);
+        return s;
+    }
+
+public:
+    using iterator = typename ArenaVector<T>::iterator;
+    using const_iterator = typename ArenaVector<T>::const_iterator;
+
+    explicit SlotMap(RoomArena* arena = nullptr)
+        : items(ArenaAllocator<T>(arena)), owners(ArenaAllocator<int>(arena)),
+          slots(ArenaAllocator<Slot>(arena)), freeSlots(ArenaAllocator<int>(arena)) {}
+
+    // bytes of arena memory needed to hold n objects without growing
+    static size_t storageBytes(size_t n) {
+        return n * (sizeof(T) + 2 * sizeof(int) + sizeof(Slot)) + 4 * alignof(T);
+    }
+
+    EntityHandle insert(const T& item) {
+        int s = takeSlot();
+        items.push_back(item);
+        return EntityHandle{ s, slots[s].gen };
+    }
+    EntityHandle insert(T&& item) {
+        int s = takeSlot();
+        items.push_back(std::move(item));
+        return EntityHandle{ s, slots[s].gen };
+    }
+
+    void reserve(size_t n) {
+        items.reserve(n);
+        owners.reserve(n);
+        slots.reserve(n);
+        freeSlots.reserve(n);
+    }
+
+    bool contains(const EntityHandle& h) const {
+        return h.slot >= 0 && h.slot < static_cast<int>(slots.size())
+            && slots[h.slot].gen == h.gen && slots[h.slot].dense >= 0;
+    }
+
+    // nullptr if the handle is stale (its object was removed)
+    T* get(const EntityHandle& h) { return contains(h) ? &items[slots[h.slot].dense] : nullptr; }
+    const T* get(const EntityHandle& h) const { return contains(h) ? &items[slots[h.slot].dense] : nullptr; }
+
+    // position of the object in the packed array, -1 if the handle is stale
+    int indexOf(const EntityHandle& h) const { return contains(h) ? slots[h.slot].dense : -1; }
+
+    // handle of the object currently stored at position i of the packed array
+    EntityHandle handleAt(size_t i) const {
+        int s = owners[i];
+        return EntityHandle{ s, slots[s].gen };
+    }
+
+    bool remove(const EntityHandle& h) {
+        if (!contains(h)) return false;
+        eraseAt(slots[h.slot].dense);
+        return true;
+    }
+
+    void eraseAt(size_t i) {        // Swap & Pop - the moved object keeps its slot
+        int s = owners[i];
+        size_t last = items.size() - 1;
+        if (i != last) {
+            items[i] = std::move(items[last]);
+            owners[i] = owners[last];
+            slots[owners[i]].dense = static_cast<int>(i);
+        }
+        items.pop_back();
+        owners.pop_back();
+
+        slots[s].dense = -1;
+        slots[s].gen++;
+        freeSlots.push_back(s);
+    }
+
+    iterator erase(iterator it) {   // returns the position that now holds the swapped-in object
+        size_t i = static_cast<size_t>(it - items.begin());
+        eraseAt(i);
+        return items.begin() + i;
+    }
+
+    // Drops every object and all storage - called right before the room's arena is released.
+    // New slots start past every generation handed out so far, so old handles still find nothing.
+    void release() {
+        for (const Slot& slot : slots) {
+            if (slot.gen >= firstGen)
+                firstGen = slot.gen + 1;
+        }
+        ArenaVector<T>(items.get_allocator()).swap(items);
+        ArenaVector<int>(owners.get_allocator()).swap(owners);
+        ArenaVector<Slot>(slots.get_allocator()).swap(slots);
+        ArenaVector<int>(freeSlots.get_allocator()).swap(freeSlots);
+    }
+
+    // Makes this an exact copy of other - the same objects in the same slots, so other's handles
+    // find the same objects here. The storage stays in this map's arena
+    void copyFrom(const SlotMap& other) { copyFrom(other, [](const T& item) { return item; }); }
+    template <typename Copy>
+    void copyFrom(const SlotMap& other, Copy copyItem) {    // copyItem(item) - for objects with arena memory of their own
+        items.clear();
+        items.reserve(other.items.size());
+        for (const T& item : other.items)
+            items.push_back(copyItem(item));
+        owners.assign(other.owners.begin(), other.owners.end());
+        slots.assign(other.slots.begin(), other.slots.end());
+        freeSlots.assign(other.freeSlots.begin(), other.freeSlots.end());
+        firstGen = other.firstGen;
+    }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
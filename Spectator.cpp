@@ -0,0 +1,81 @@
+#include "FrameShare.h"
+#include "Utils.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// File: Spectator.cpp
+// Description:
+//   Mirrors the frames of a game started with -spectate (see FrameShare.h) in another terminal.
+//   It only reads the shared memory, so it never slows the game down. Frames it missed while
+//   the game ran ahead are skipped - the next one it sees is drawn whole.
+//   Waits for a game to appear, and for the next one when it ends. Any key stops it.
+
+namespace {
+    constexpr int POLL_MS = 15;         // about a frame of the game
+    constexpr int WAIT_MS = 500;        // between attempts to find a game
+
+    void showWaiting()
+    {
+        Utils::clearScreen();
+        Utils::gotoxy(0, 0);
+        std::cout << "Waiting for a game started with -spectate... (any key to stop)" << std::flush;
+    }
+
+    // Rows of the frame that differ from what the terminal shows, in one write
+    void draw(const FrameData& frame, bool whole)
+    {
+        std::string out;
+        for (int y = 0; y < SCREEN_HEIGHT; y++) {
+            if (!whole && !frame.isDirty(y))
+                continue;
+            char move[16];
+            int len = std::snprintf(move, sizeof(move), "\033[%d;1H", y + 1);
+            out.append(move, len);
+            out.append(frame.cells[y], SCREEN_WIDTH);
+        }
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cout.flush();
+    }
+}
+
+int main()
+{
+    Utils::initConsole();
+    Utils::hideCursor();
+    showWaiting();
+
+    FrameShare share;
+    FrameData frame;
+    bool drawn = false;                 // the terminal shows frame 'shown'
+    std::uint32_t shown = 0;
+
+    while (!Utils::hasInput()) {
+        if (!share.isOpen()) {
+            if (!share.attach()) {
+                Utils::delay(WAIT_MS);
+                continue;
+            }
+            drawn = false;
+        }
+        if (!share.isLive()) {          // the game ended
+            share.close();
+            showWaiting();
+            continue;
+        }
+
+        if (share.latest(frame) && (!drawn || frame.number != shown)) {
+            draw(frame, !drawn || frame.number != shown + 1);
+            shown = frame.number;
+            drawn = true;
+        }
+        Utils::delay(POLL_MS);
+    }
+    Utils::getChar();
+
+    share.close();
+    Utils::clearScreen();
+    Utils::showCursor();
+    Utils::restoreConsole();
+    return 0;
+}
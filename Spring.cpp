@@ -8,25 +8,14 @@ Point Spring::getTipPos() const {
 
 // Returns the coordinate of spring link number 'index'
 Point Spring::getLinkPos(int index) const {
-    int x = basePos.getX();
-    int y = basePos.getY();
-
-    switch (dir) {
-    case RIGHT: x += index; break;
-    case LEFT: x -= index; break;
-    case UP: y -= index; break;
-    case DOWN: y += index; break;
-    default: break;
-    }
-    return { x,y };
+    return basePos.next(dir, index);
 }
 
 // Checks whether point p lies on the spring's extended body
 bool Spring::isSpringBody(const Point& p) const {
-    for (int i = 0; i < currSize; i++) {
-        if (getLinkPos(i) == p) return true;
-    }
-    return false;
+    // link number p would have if it lies on the spring's line
+    int index = (p.getX() - basePos.getX()) * DIR_DX[dir] + (p.getY() - basePos.getY()) * DIR_DY[dir];
+    return index >= 0 && index < currSize && getLinkPos(index) == p;
 }
 
 // True if the player is facing the spring (for compression)
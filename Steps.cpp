@@ -1,6 +1,5 @@
 #include "Steps.h"
 #include <fstream>
-#include <sstream>
 
 
 void Steps::addStep(size_t iteration, char step) {   
@@ -9,31 +8,83 @@ void Steps::addStep(size_t iteration, char step) {
         return;
 
     steps.emplace_back(iteration, step); // Adds a step with its iteration
+
+    if (journal)
+        journal->append(std::to_string(iteration) + ' ' + step + '\n');
 }
-Steps* Steps::loadSteps(std::ifstream& file) {
-    Steps* steps = new Steps();
-    std::string line;
 
-    while (std::getline(file, line)) {
-        if (line.empty())
-            continue;
+void Steps::startJournal(JournalWriter* to, const std::vector<ScreenId>& screens) {
+    // Same header as saveSteps(), the steps follow as they are added
+    std::string header = "# screens\n";
+    for (const auto& screen : screens)
+        header += screen.line() + '\n';
+    header += "# steps\n";
+
+    journal = to;
+    journal->append(header);
+}
+bool TextStepSource::next(size_t& iteration, char& key) {
+    LineCursor line;
 
-        std::istringstream iss(line);
-        size_t iteration;
-        char key;
+    while (file->nextLine(line)) {
+        if (line.text().empty())
+            continue;
 
-        if (!(iss >> iteration >> key)) {
-            delete steps;
-            return nullptr;
+        if (!(line.readSize(iteration) && line.readChar(key))) {
+            if (!file->isLineComplete())    // torn last write of a journal - the recording ends before it
+                return false;
+            error = file->getFilename() + " " + line.where() + ": expected <iteration> <key>";
+            return false;
         }
+        return true;
+    }
+    error = file->getError();
+    return false;
+}
 
-        steps->addStep(iteration, key);
+Steps* Steps::openSteps(std::unique_ptr<StepSource> from, std::string& errorMsg) {
+    Steps* steps = new Steps();
+    steps->source = std::move(from);
+    steps->readNext();
+
+    if (!steps->readError.empty()) {
+        errorMsg = steps->readError;
+        delete steps;
+        return nullptr;
     }
     return steps;
 }
 
+void Steps::readNext() {
+    size_t iteration;
+    char key;
+    hasNext = false;
+
+    while (source->next(iteration, key)) {
+        if (key == lastKey)     // Ignore repeated direction
+            continue;
+
+        next = { iteration, key };
+        lastKey = key;
+        hasNext = true;
+        return;
+    }
+    readError = source->getError();
+}
+
+char Steps::popStep() {
+    if (source) {
+        char step = next.second;
+        readNext();
+        return step;
+    }
+    char step = steps.front().second;
+    steps.pop_front();
+    return step;
+}
+
 bool Steps::saveSteps(const std::string& filename,
-    const std::vector<std::string>& screenFiles) const
+    const std::vector<ScreenId>& screens) const
 {
     // Open steps file (overwrites existing file)
     std::ofstream file(filename);
@@ -42,8 +93,8 @@ bool Steps::saveSteps(const std::string& filename,
 
     file << "# screens\n";
     // Write screen files header to ensure replay consistency
-    for (const auto& name : screenFiles) {
-        file << name << '\n';
+    for (const auto& screen : screens) {
+        file << screen.line() << '\n';
     }
 
     // steps header
@@ -55,4 +106,23 @@ bool Steps::saveSteps(const std::string& filename,
     }
 
     return true;
-}
\ No newline at end of file
+}
+bool InputChannel::push(size_t tick, const TickInput& input) {
+    if (tick != knownUntil())
+        return false;
+    inputs.push_back(input);
+    return true;
+}
+
+TickInput InputChannel::at(size_t tick) const {
+    if (tick < first || !isKnown(tick))
+        return TickInput();
+    return inputs[tick - first];
+}
+
+void InputChannel::dropBefore(size_t tick) {
+    while (first < tick && !inputs.empty()) {
+        inputs.pop_front();
+        first++;
+    }
+}
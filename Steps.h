@@ -1,26 +1,97 @@
 #pragma once
+#include "TextScanner.h"
+#include "LineStream.h"
+#include "JournalWriter.h"
+#include "ScreenId.h"
+#include <deque>
 #include <iosfwd>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
+// Where played-back steps come from - a text steps file or a binary recording (see Recording.h)
+class StepSource {
+public:
+    virtual ~StepSource() = default;
+    virtual bool next(size_t& iteration, char& key) = 0;    // false at the end or on a bad entry
+    virtual const std::string& getError() const = 0;        // why reading stopped early (empty at the end)
+};
+
+// Steps of a text steps file (positioned after its header), one "<iteration> <key>" per line
+class TextStepSource : public StepSource {
+private:
+    std::unique_ptr<LineStream> file;
+    std::string error;
+
+public:
+    explicit TextStepSource(std::unique_ptr<LineStream> _file) : file(std::move(_file)) {}
+    bool next(size_t& iteration, char& key) override;
+    const std::string& getError() const override { return error; }
+};
+
+// What one player did on one tick of a network game: the key pressed (0 - none) and the answer to
+// the riddle the player stands at (NO_ANSWER - none)
+struct TickInput {
+    static constexpr signed char NO_ANSWER = -1;
+
+    char key = 0;
+    signed char riddle = NO_ANSWER;     // 1 solved, 0 wrong
+
+    bool isEmpty() const { return key == 0 && riddle == NO_ANSWER; }
+};
+
+// The inputs of one player by tick, as the clients of a network game exchange them (see NetworkGame.h).
+// They arrive in tick order. A tick whose input didn't arrive yet reads as empty - the game predicts
+// the player did nothing new, and simulates the tick again if that was wrong.
+class InputChannel {
+private:
+    std::deque<TickInput> inputs;       // inputs[i] is the input of tick first + i
+    size_t first = 0;
+
+public:
+    void reset(size_t firstTick) { inputs.clear(); first = firstTick; }
+    size_t knownUntil() const { return first + inputs.size(); }    // first tick without an input
+    bool isKnown(size_t tick) const { return tick < knownUntil(); }
+
+    bool push(size_t tick, const TickInput& input);     // false unless it's the tick after the last one
+    TickInput at(size_t tick) const;
+    void dropBefore(size_t tick);       // the game won't simulate these again
+};
+
 class Steps {
 private:
-    std::list<std::pair<size_t, char>> steps; // pair: <iteration, direction>
+    std::list<std::pair<size_t, char>> steps; // recorded steps - pair: <iteration, direction>
+
+    // Playback: only the next step is held, the rest is read when the game reaches it
+    std::unique_ptr<StepSource> source;
+    std::pair<size_t, char> next;
+    bool hasNext = false;
+    char lastKey = 0;                       // last step read (repeated directions are ignored, as in addStep)
+    std::string readError;
+
+    JournalWriter* journal = nullptr;       // save mode: every added step is appended to it
+
+    void readNext();
 
 public:
     void addStep(size_t iteration, char step);
+    const std::list<std::pair<size_t, char>>& getRecorded() const { return steps; }
 
-    static Steps* loadSteps(std::ifstream& file);
-    bool saveSteps(const std::string& filename, const std::vector<std::string>& screenFiles) const;
+    // Writes the file header to the journal, then every step added from now on
+    void startJournal(JournalWriter* to, const std::vector<ScreenId>& screens);
+    void stopJournal() { journal = nullptr; }
 
-    bool isEmpty() const { return steps.empty(); }
+    // Starts playing back steps from a source. nullptr if the first step is bad
+    static Steps* openSteps(std::unique_ptr<StepSource> from, std::string& errorMsg);
+    bool saveSteps(const std::string& filename, const std::vector<ScreenId>& screens) const;
+
+    bool isEmpty() const { return source ? !hasNext : steps.empty(); }
     bool isNextStepOnIteration(size_t iteration) const {
+        if (source)
+            return hasNext && next.first == iteration;
         return !steps.empty() && steps.front().first == iteration;
     }
-    char popStep() {
-        char step = steps.front().second;
-        steps.pop_front();
-        return step;
-    }
-};
\ No newline at end of file
+    char popStep();
+    const std::string& getReadError() const { return readError; }     // why playback stopped early
+};
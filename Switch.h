@@ -26,6 +26,7 @@ public:
 	Point getPos() const { return pos; }
 	int getDoorID() const { return doorID; }
 	bool getState() const { return state; }
+	bool isShown() const { return true; }
 	char getFigure() const { return state ? '/' : 'o'; }\
 
 	void toggle()  // Toggles the switch state. If it was ON, it becomes OFF, and vice-versa
@@ -1,24 +1,19 @@
 #pragma once
+#include "EntityStore.h"
 
 //learned by ourselves when saw too much duplicates of the same funcs
 template <typename T> //means the next func isn't a reg func, it's a template
-T* getItemAt(std::vector<T>& list, const Point& p) { //'T' is deduced automatically based on the vector passed
-	for (auto& item : list) {
-
-		if (item.getPos() == p) return &item;
-	}
-	return nullptr; //item wasn't found
+T* getItemAt(EntityStore<T>& list, const Point& p) { //'T' is deduced automatically based on the list passed
+	int i = list.indexAt(p);     // scans the packed positions only
+	if (i < 0) return nullptr;   //item wasn't found
+	return &list[i];
 }
 
 template <typename T>
-// delete template func using iterator for going through the vector list
-bool removeItemAt(std::vector<T>& list, const Point& p) {
-	for (auto it = list.begin(); it != list.end(); ++it) {
-		if (it->getPos() == p) {
-			*it = std::move(list.back()); // Swap & Pop
-			list.pop_back();
-			return true;
-		}
-	}
-	return false;
+// delete template func going through the list - handles of the other items stay valid
+bool removeItemAt(EntityStore<T>& list, const Point& p) {
+	int i = list.indexAt(p);
+	if (i < 0) return false;
+	list.eraseAt(i); // Swap & Pop
+	return true;
 }
@@ -0,0 +1,163 @@
+#include "TextScanner.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Reads the digits at p into value - false if there are none or the value does not fit in max
+    template <typename T>
+    bool parseDigits(const char*& p, const char* end, T max, T& value) {
+        const char* start = p;
+        T v = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+            T digit = static_cast<T>(*p - '0');
+            if (v > (max - digit) / 10) {
+                p = start;
+                return false;
+            }
+            v = v * 10 + digit;
+        }
+        if (p == start)
+            return false;
+        value = v;
+        return true;
+    }
+}
+
+bool TextView::operator==(const char* s) const
+{
+    return (size == 0 || std::strncmp(data, s, size) == 0) && s[size] == '\0';
+}
+
+void LineCursor::skipBlanks()
+{
+    while (pos < end && ::isBlank(*pos))
+        ++pos;
+}
+
+bool LineCursor::readWord(TextView& out)
+{
+    skipBlanks();
+    const char* start = pos;
+    while (pos < end && !::isBlank(*pos))
+        ++pos;
+    out = TextView(start, pos - start);
+    return pos != start;
+}
+
+bool LineCursor::readInt(int& out)
+{
+    skipBlanks();
+    const char* p = pos;
+    bool negative = (p < end && (*p == '-' || *p == '+')) ? (*p++ == '-') : false;
+
+    // -(INT_MIN) does not fit in an int, so the magnitude is read as unsigned
+    unsigned max = static_cast<unsigned>(std::numeric_limits<int>::max()) + (negative ? 1u : 0u);
+    unsigned value;
+    if (!parseDigits(p, end, max, value))
+        return false;
+
+    out = negative ? static_cast<int>(0u - value) : static_cast<int>(value);
+    pos = p;
+    return true;
+}
+
+bool LineCursor::readSize(size_t& out)
+{
+    skipBlanks();
+    const char* p = pos;
+    if (p < end && *p == '+')
+        ++p;
+    if (!parseDigits(p, end, std::numeric_limits<size_t>::max(), out))
+        return false;
+    pos = p;
+    return true;
+}
+
+bool LineCursor::readChar(char& out)
+{
+    skipBlanks();
+    if (pos == end)
+        return false;
+    out = *pos++;
+    return true;
+}
+
+bool LineCursor::readBool(bool& out)
+{
+    int value;
+    const char* start = pos;
+    if (!readInt(value))
+        return false;
+    if (value != 0 && value != 1) {
+        pos = start;
+        return false;
+    }
+    out = (value == 1);
+    return true;
+}
+
+bool LineCursor::readQuoted(std::string& out)
+{
+    skipBlanks();
+    if (pos == end)
+        return false;
+    if (*pos != '"')                // not quoted - a plain word, as std::quoted reads it
+    {
+        TextView word;
+        readWord(word);
+        out = word.str();
+        return true;
+    }
+
+    const char* p = pos + 1;
+    out.clear();
+    while (p < end && *p != '"') {
+        if (*p == '\\' && p + 1 < end)
+            ++p;
+        out += *p++;
+    }
+    if (p == end)                   // no closing quote
+        return false;
+
+    pos = p + 1;
+    return true;
+}
+
+bool LineCursor::atEnd()
+{
+    skipBlanks();
+    return pos == end;
+}
+
+bool LineCursor::isBlank() const
+{
+    for (const char* p = begin; p < end; ++p)
+        if (!::isBlank(*p)) return false;
+    return true;
+}
+
+std::string LineCursor::where() const
+{
+    return "line " + std::to_string(lineNumber) + ", column " + std::to_string(column());
+}
+
+bool TextScanner::nextLine(LineCursor& line)
+{
+    if (pos == end)
+        return false;
+
+    const char* start = pos;
+    const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    const char* stop = newline ? newline : end;
+    pos = newline ? newline + 1 : end;
+
+    if (stop > start && stop[-1] == '\r')       // "\r\n" line break
+        --stop;
+
+    line = LineCursor(TextView(start, stop - start), ++lineNumber);
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+// File: TextScanner.h
+// Description:
+//   Shared tokenizer for every text format of the game (screen rules, steps, results, riddles).
+//   It works in place on a buffer - normally a memory-mapped file (see MappedFile.h) - handing out
+//   slices of it instead of copying each line into a std::string and a stringstream.
+//   Numbers are converted straight from the buffer. Failures can say exactly where they happened
+//   (line and column).
+
+// A slice of a text buffer that must outlive it (a small stand-in for std::string_view,
+// which the project's C++14 target does not have)
+struct TextView {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    TextView() = default;
+    TextView(const char* _data, size_t _size) : data(_data), size(_size) {}
+
+    bool empty() const { return size == 0; }
+    char operator[](size_t i) const { return data[i]; }
+    bool operator==(const char* s) const;
+    bool operator!=(const char* s) const { return !(*this == s); }
+    std::string str() const { return std::string(data, size); }
+};
+
+// Reads one line token by token. Tokens are separated by blanks, the same way operator>> splits them.
+// Every read* skips the blanks before the token and returns false (consuming nothing) if there is
+// no token of that kind.
+class LineCursor {
+private:
+    const char* begin = nullptr;
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    int lineNumber = 0;
+
+    void skipBlanks();
+
+public:
+    LineCursor() = default;
+    LineCursor(TextView line, int _lineNumber)
+        : begin(line.data), pos(line.data), end(line.data + line.size), lineNumber(_lineNumber) {}
+
+    bool readWord(TextView& out);
+    bool readInt(int& out);
+    bool readSize(size_t& out);
+    bool readChar(char& out);               // next non-blank character
+    bool readBool(bool& out);               // 0 or 1, like operator>> for bool
+    bool readQuoted(std::string& out);      // "text" with \" and \\ escapes, like std::quoted
+    bool atEnd();                           // nothing but blanks left
+
+    TextView text() const { return TextView(begin, end - begin); }     // the whole line
+    bool isBlank() const;
+    int line() const { return lineNumber; }
+    int column() const { return static_cast<int>(pos - begin) + 1; }
+    std::string where() const;              // "line L, column C" of the next unread character
+};
+
+// Splits a buffer into lines ('\n' or "\r\n" line breaks, a last line without one is fine)
+class TextScanner {
+private:
+    const char* pos;
+    const char* end;
+    int lineNumber = 0;
+
+public:
+    TextScanner(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    bool nextLine(LineCursor& line);
+    bool atEnd() const { return pos == end; }
+    int line() const { return lineNumber; }         // number of the last line handed out (1-based)
+};
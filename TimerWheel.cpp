@@ -0,0 +1,202 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+int TimerWheel::allocNode()
+{
+    if (!freeNodes.empty()) {
+        int n = freeNodes.back();
+        freeNodes.pop_back();
+        return n;
+    }
+    nodes.emplace_back();
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void TimerWheel::place(int n)
+{
+    size_t d = nodes[n].deadline;
+
+    // Same 256-tick block as now -> exact level 0 bucket, otherwise park it in level 1
+    // until its block comes up (timers further than 64 blocks away are re-parked on cascade)
+    if ((d >> LEVEL0_BITS) == (currTick >> LEVEL0_BITS))
+        link(n, static_cast<int>(d & (LEVEL0_SIZE - 1)));
+    else
+        link(n, static_cast<int>(LEVEL0_SIZE + ((d >> LEVEL0_BITS) & (LEVEL1_SIZE - 1))));
+}
+
+void TimerWheel::link(int n, int bucket)
+{
+    Node& node = nodes[n];
+    Bucket& b = buckets[bucket];
+
+    node.bucket = bucket;
+    node.next = -1;
+    node.prev = b.tail;
+
+    if (b.tail >= 0) nodes[b.tail].next = n;
+    else b.head = n;
+    b.tail = n;
+}
+
+void TimerWheel::unlink(int n)
+{
+    Node& node = nodes[n];
+    Bucket& b = buckets[node.bucket];
+
+    if (node.prev >= 0) nodes[node.prev].next = node.next;
+    else b.head = node.next;
+
+    if (node.next >= 0) nodes[node.next].prev = node.prev;
+    else b.tail = node.prev;
+
+    node.prev = node.next = -1;
+    node.bucket = -1;
+}
+
+void TimerWheel::release(int n)
+{
+    nodes[n].bucket = -1;
+    nodes[n].gen++;       // invalidates every handle to this node
+    freeNodes.push_back(n);
+    pending--;
+}
+
+void TimerWheel::cascade()
+{
+    int bucket = static_cast<int>(LEVEL0_SIZE + ((currTick >> LEVEL0_BITS) & (LEVEL1_SIZE - 1)));
+
+    // Detach the whole list first - nodes that are still far away go back to the same bucket
+    int n = buckets[bucket].head;
+    buckets[bucket].head = buckets[bucket].tail = -1;
+
+    while (n >= 0) {
+        int next = nodes[n].next;
+        place(n);
+        n = next;
+    }
+}
+
+TimerHandle TimerWheel::insert(size_t deadline, const TimerEvent& ev)
+{
+    if (deadline <= currTick)
+        deadline = currTick + 1;    // a timer can't fire in the past
+
+    int n = allocNode();
+    Node& node = nodes[n];
+    node.event = ev;
+    node.deadline = deadline;
+
+    TimerHandle h{ n, node.gen };
+    node.event.handle = h;
+
+    place(n);
+    pending++;
+    return h;
+}
+
+TimerHandle TimerWheel::schedule(int delay, const TimerEvent& ev)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (delay < 1) delay = 1;
+    return insert(currTick + static_cast<size_t>(delay), ev);
+}
+
+TimerHandle TimerWheel::scheduleAt(size_t deadline, const TimerEvent& ev)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return insert(deadline, ev);
+}
+
+bool TimerWheel::pendingNode(const TimerHandle& h) const
+{
+    return h.node >= 0 && h.node < static_cast<int>(nodes.size()) &&
+        nodes[h.node].gen == h.gen && nodes[h.node].bucket >= 0;
+}
+
+size_t TimerWheel::deadlineOf(const TimerHandle& h) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return pendingNode(h) ? nodes[h.node].deadline : currTick;
+}
+
+bool TimerWheel::cancel(TimerHandle& h)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    bool wasPending = pendingNode(h);
+    if (wasPending) {
+        unlink(h.node);
+        release(h.node);
+    }
+    h = TimerHandle{};
+    return wasPending;
+}
+
+bool TimerWheel::hasRoom(int roomID) const
+{
+    // Linear in the number of timer nodes - only used when rooms are unloaded
+    std::lock_guard<std::mutex> guard(lock);
+    for (const Node& node : nodes) {
+        if (node.bucket >= 0 && node.event.roomID == roomID)
+            return true;
+    }
+    return false;
+}
+
+void TimerWheel::cancelRoom(int roomID)
+{
+    // Linear in the number of timer nodes - only used when a room is restarted
+    std::lock_guard<std::mutex> guard(lock);
+    for (int n = 0; n < static_cast<int>(nodes.size()); n++) {
+        if (nodes[n].bucket >= 0 && nodes[n].event.roomID == roomID) {
+            unlink(n);
+            release(n);
+        }
+    }
+}
+
+void TimerWheel::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    nodes.clear();
+    freeNodes.clear();
+    for (Bucket& b : buckets)
+        b = Bucket{};
+    currTick = 0;
+    pending = 0;
+}
+
+void TimerWheel::copyFrom(const TimerWheel& other)
+{
+    if (&other == this)
+        return;
+    std::unique_lock<std::mutex> mine(lock, std::defer_lock);
+    std::unique_lock<std::mutex> theirs(other.lock, std::defer_lock);
+    std::lock(mine, theirs);
+
+    nodes = other.nodes;
+    freeNodes = other.freeNodes;
+    std::copy(other.buckets, other.buckets + LEVEL0_SIZE + LEVEL1_SIZE, buckets);
+    currTick = other.currTick;
+    pending = other.pending;
+}
+
+void TimerWheel::advance(std::vector<TimerEvent>& expired)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    expired.clear();
+    currTick++;
+
+    if ((currTick & (LEVEL0_SIZE - 1)) == 0)
+        cascade();
+
+    Bucket& b = buckets[currTick & (LEVEL0_SIZE - 1)];
+    int n = b.head;
+    b.head = b.tail = -1;
+
+    while (n >= 0) {
+        int next = nodes[n].next;
+        expired.push_back(nodes[n].event);
+        release(n);
+        n = next;
+    }
+}
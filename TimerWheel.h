@@ -0,0 +1,95 @@
+#pragma once
+#include "Point.h"
+#include "SlotMap.h"
+#include <vector>
+#include <cstddef>
+#include <mutex>
+
+// File: TimerWheel.h
+// Description:
+//   Two-level hierarchical timer wheel that schedules every timed entity of the game
+//   (armed bombs, player respawn and spring acceleration) in all rooms.
+//   advance() costs O(1) per tick plus the number of timers that actually expire,
+//   no matter how many timers are pending.
+//   Rooms are simulated in parallel, so every public call is guarded by the wheel's lock.
+
+enum class TimerType { BombExplode, PlayerRespawn, AccelEnd };
+
+// Identifies a scheduled timer. The generation makes stale handles harmless:
+// once a timer fired or was cancelled its node may be reused by another timer.
+struct TimerHandle {
+    int node = -1;
+    unsigned gen = 0;
+
+    bool isSet() const { return node >= 0; }
+    bool operator==(const TimerHandle& other) const { return node == other.node && gen == other.gen; }
+    bool operator!=(const TimerHandle& other) const { return !(*this == other); }
+};
+
+// Payload delivered when a timer expires
+struct TimerEvent {
+    TimerType type = TimerType::BombExplode;
+    int roomID = -1;        // room the timer belongs to (-1 if it follows a player)
+    int owner = -1;         // player index for player timers
+    EntityHandle entity;    // the armed bomb for bomb timers
+    TimerHandle handle;     // filled by the wheel - the handle this event was scheduled with
+};
+
+class TimerWheel {
+private:
+    static constexpr int LEVEL0_BITS = 8;                   // 256 one-tick buckets
+    static constexpr int LEVEL1_BITS = 6;                   // 64 buckets of 256 ticks each
+    static constexpr size_t LEVEL0_SIZE = size_t(1) << LEVEL0_BITS;
+    static constexpr size_t LEVEL1_SIZE = size_t(1) << LEVEL1_BITS;
+
+    struct Node {
+        TimerEvent event;
+        size_t deadline = 0;
+        int prev = -1, next = -1;   // intrusive bucket list
+        int bucket = -1;            // bucket index (level 1 buckets are offset by LEVEL0_SIZE), -1 when free
+        unsigned gen = 0;
+    };
+
+    struct Bucket {
+        int head = -1, tail = -1;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    Bucket buckets[LEVEL0_SIZE + LEVEL1_SIZE];
+    size_t currTick = 0;
+    size_t pending = 0;
+    mutable std::mutex lock;
+
+    int allocNode();
+    void place(int n);                    // links node into the bucket matching its deadline
+    void link(int n, int bucket);
+    void unlink(int n);
+    void release(int n);
+    void cascade();                       // moves the next level 1 bucket down to level 0
+    bool pendingNode(const TimerHandle& h) const;
+    TimerHandle insert(size_t deadline, const TimerEvent& ev);
+
+public:
+    TimerWheel() = default;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    size_t now() const { std::lock_guard<std::mutex> guard(lock); return currTick; }
+    size_t size() const { std::lock_guard<std::mutex> guard(lock); return pending; }
+
+    TimerHandle schedule(int delay, const TimerEvent& ev);      // fires after 'delay' (>= 1) calls to advance()
+    TimerHandle scheduleAt(size_t deadline, const TimerEvent& ev);
+    bool cancel(TimerHandle& h);
+    void cancelRoom(int roomID);          // drops every timer bound to a room (room restart)
+    bool hasRoom(int roomID) const;       // a timer bound to the room is pending
+    void clear();
+    void copyFrom(const TimerWheel& other);     // every pending timer, under the same handles
+
+    bool isPending(const TimerHandle& h) const { std::lock_guard<std::mutex> guard(lock); return pendingNode(h); }
+    size_t deadlineOf(const TimerHandle& h) const;
+
+    // Moves time forward by one tick and appends the events that expired to 'expired'
+    // (the vector is cleared first). Events fire in the order they were scheduled.
+    void advance(std::vector<TimerEvent>& expired);
+};
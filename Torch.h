@@ -20,6 +20,7 @@ public:
 	Point getPos() const { return pos; }
 	char getFigure() const { return figure; }
 	bool isActive() const { return active; }
+	bool isShown() const { return active; }       // drawn on the board
 	void setPos(Point pos) { this->pos = pos; }
 
 	void activate() { active = true; }          // Marks the torch as available (visible on screen).
@@ -11,6 +11,8 @@ using namespace std;
 static struct termios oldSettings;
 #endif
 
+static unsigned clearCount = 0;
+
 void Utils::gotoxy(int x, int y) {
 #ifdef _WIN32
 	HANDLE hConsoleOutput;
@@ -90,6 +92,7 @@ void Utils::showCursor()
 }
 
 void Utils::clearScreen() {
+	clearCount++;
 #ifdef _WIN32
 	system("cls");
 #else
@@ -97,8 +100,18 @@ void Utils::clearScreen() {
 #endif
 }
 
+unsigned Utils::screenClears() {
+	return clearCount;
+}
+
 void Utils::initConsole() {
-#ifndef _WIN32
+#ifdef _WIN32
+	// Frames are written as one block with cursor moves (see FrameCompositor)
+	HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+	DWORD mode = 0;
+	if (GetConsoleMode(out, &mode))
+		SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
 	tcgetattr(STDIN_FILENO, &oldSettings);
 	struct termios newSettings = oldSettings;
 	newSettings.c_lflag &= ~(ICANON | ECHO); //  Enter  
@@ -113,4 +126,13 @@ void Utils::restoreConsole() {
 	tcsetattr(STDIN_FILENO, TCSANOW, &oldSettings);
 #endif
 	showCursor();
-}
\ No newline at end of file
+}
+
+std::uint64_t Utils::hashBytes(const void* data, size_t size, std::uint64_t hash) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
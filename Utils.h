@@ -2,6 +2,8 @@
 #include <thread>
 #include <chrono>
 #include <string>
+#include <cstdint>
+#include <cstddef>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -21,10 +23,15 @@ namespace Utils {
     std::string toUpperCase(std::string str);
     void delay(int ms);
 
+    // 64-bit FNV-1a hash - chain calls by passing the previous result as 'hash'
+    constexpr std::uint64_t HASH_SEED = 14695981039346656037ull;
+    std::uint64_t hashBytes(const void* data, size_t size, std::uint64_t hash = HASH_SEED);
+
     // Screen Functions
     void hideCursor();
     void showCursor();
     void clearScreen();
+    unsigned screenClears();    // how often the screen was cleared - a frame drawn before is gone
     void initConsole();
     void restoreConsole();
 
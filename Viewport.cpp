@@ -0,0 +1,28 @@
+#include "Viewport.h"
+#include "FrameCompositor.h"
+#include <iostream>
+
+void Viewport::text(const Point& at, const char* chars, int count) const
+{
+    int x = at.getX();
+    int y = at.getY();
+    if (y < 0 || y >= height)
+        return;
+    if (x < 0) {
+        chars -= x;
+        count += x;
+        x = 0;
+    }
+    count = std::min(count, width - x);
+    if (count <= 0)
+        return;
+
+    Point cell(screenPos.getX() + x, screenPos.getY() + y);
+    if (frame) {
+        frame->write(pane, cell, chars, count);
+    }
+    else {
+        Utils::gotoxy(cell.getX(), cell.getY());
+        std::cout.write(chars, count);
+    }
+}
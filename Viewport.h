@@ -0,0 +1,75 @@
+#pragma once
+#include "Point.h"
+#include "Utils.h"
+#include <algorithm>
+#include <string>
+
+class FrameCompositor;
+
+// File: Viewport.h
+// Description:
+//   The window of a room that is shown on the terminal - the whole terminal (SCREEN_WIDTH x
+//   SCREEN_HEIGHT cells) or one pane of a split frame (see FrameCompositor.h).
+//   A standard room fills the whole terminal exactly, so the view stays at (0,0) and everything is
+//   drawn where it always was. In a larger room the view follows the players: it moves once the
+//   followed point comes closer than VIEW_MARGIN cells to an edge of the window, and it never leaves
+//   the room. The board is read only inside the window, and objects (and dark areas) outside it are
+//   skipped before they are drawn - a frame costs the window's cells plus one bounds test per object.
+//   Output goes to the pane's compositor when it has one, straight to the console otherwise.
+
+constexpr int VIEW_MARGIN = 10;        // cells kept between the followed point and the window's edge
+
+class Viewport {
+private:
+    Point origin;                       // room cell shown at the window's top left
+    Point screenPos;                    // terminal cell of the window's top left
+    int width = SCREEN_WIDTH;
+    int height = SCREEN_HEIGHT;
+    FrameCompositor* frame = nullptr;   // null - draw straight to the console
+    int pane = -1;
+
+    static int followAxis(int start, int target, int window, int roomSide) {
+        if (roomSide <= window)
+            return 0;
+        int margin = std::min(VIEW_MARGIN, window / 2);
+        if (target < start + margin)
+            start = target - margin;
+        else if (target >= start + window - margin)
+            start = target - window + margin + 1;
+        return std::max(0, std::min(start, roomSide - window));
+    }
+
+public:
+    Viewport() = default;
+    Viewport(FrameCompositor* _frame, int _pane, const Point& _screenPos, int _width, int _height)
+        : screenPos(_screenPos), width(_width), height(_height), frame(_frame), pane(_pane) {}
+
+    const Point& getOrigin() const { return origin; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    void reset() { origin = Point(0, 0); }
+
+    bool contains(const Point& p) const {
+        return p.getX() >= origin.getX() && p.getX() < origin.getX() + width &&
+            p.getY() >= origin.getY() && p.getY() < origin.getY() + height;
+    }
+    bool overlaps(const Point& topLeft, const Point& bottomRight) const {     // a box of room cells
+        return bottomRight.getX() >= origin.getX() && topLeft.getX() < origin.getX() + width &&
+            bottomRight.getY() >= origin.getY() && topLeft.getY() < origin.getY() + height;
+    }
+    Point toWindow(const Point& p) const { return Point(p.getX() - origin.getX(), p.getY() - origin.getY()); }
+
+    // Moves the window just enough to keep target away from its edges
+    void follow(const Point& target, const BoardSize& room) {
+        origin = Point(followAxis(origin.getX(), target.getX(), width, room.width),
+            followAxis(origin.getY(), target.getY(), height, room.height));
+    }
+
+    // Output - clipped to the window
+    void put(const Point& roomPos, char c) const {     // one room cell
+        if (contains(roomPos))
+            text(toWindow(roomPos), &c, 1);
+    }
+    void text(const Point& at, const char* chars, int count) const;    // at: window coordinates
+    void text(const Point& at, const std::string& s) const { text(at, s.data(), static_cast<int>(s.size())); }
+};
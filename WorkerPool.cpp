@@ -0,0 +1,88 @@
+#include "WorkerPool.h"
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& t : workers)
+        t.join();
+}
+
+void WorkerPool::start()
+{
+    // One thread less than the machine has - the thread calling run() works as well
+    unsigned hw = std::thread::hardware_concurrency();
+    int count = (hw > 1) ? static_cast<int>(hw) - 1 : 1;
+
+    for (int i = 0; i < count; i++)
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+void WorkerPool::workerLoop()
+{
+    size_t seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || batch != seen; });
+            if (stopping) return;
+            seen = batch;
+        }
+        runJobs();
+    }
+}
+
+void WorkerPool::runJobs()
+{
+    while (true) {
+        const std::function<void(int)>* fn;
+        int i;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (nextJob >= jobCount) return;
+            fn = job;
+            i = nextJob++;
+        }
+
+        (*fn)(i);
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (--unfinished == 0)
+            done.notify_all();
+    }
+}
+
+void WorkerPool::run(int count, const std::function<void(int)>& fn)
+{
+    if (count <= 0) return;
+
+    if (count == 1) {           // nothing to share
+        fn(0);
+        return;
+    }
+
+    if (workers.empty())
+        start();
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        job = &fn;
+        jobCount = count;
+        nextJob = 0;
+        unfinished = count;
+        batch++;
+    }
+    wake.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [this] { return unfinished == 0; });
+    job = nullptr;
+    jobCount = nextJob = 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+// Small fixed pool of worker threads used to simulate independent rooms side by side.
+// run() hands out job indices to the workers and to the calling thread and returns only
+// once every job finished, so the caller can merge the results right after it.
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake;       // workers wait here for a new batch
+    std::condition_variable done;       // run() waits here for the batch to finish
+
+    const std::function<void(int)>* job = nullptr;
+    int jobCount = 0;
+    int nextJob = 0;
+    int unfinished = 0;
+    size_t batch = 0;                   // incremented for every run() - wakes the workers
+    bool stopping = false;
+
+    void start();
+    void workerLoop();
+    void runJobs();                     // claims jobs of the current batch until none is left
+
+public:
+    WorkerPool() = default;             // threads are only created on the first run()
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Calls fn(0) ... fn(count - 1), possibly in parallel, and waits for all of them
+    void run(int count, const std::function<void(int)>& fn);
+};